@@ -5,7 +5,7 @@
 #include <queue>
 
 // Constructor
-Graph::Graph(int v, bool isDirected) : vertices(v), directed(isDirected) {
+Graph::Graph(int v, bool isDirected) : vertices(v), directed(isDirected), edgeHash(0) {
     if (v <= 0) {
         throw std::invalid_argument("Number of vertices must be positive");
     }
@@ -13,7 +13,8 @@ Graph::Graph(int v, bool isDirected) : vertices(v), directed(isDirected) {
 }
 
 // Copy constructor
-Graph::Graph(const Graph& other) : vertices(other.vertices), directed(other.directed) {
+Graph::Graph(const Graph& other)
+    : vertices(other.vertices), directed(other.directed), edgeHash(other.edgeHash) {
     adjList = other.adjList;
 }
 
@@ -23,6 +24,7 @@ Graph& Graph::operator=(const Graph& other) {
         vertices = other.vertices;
         directed = other.directed;
         adjList = other.adjList;
+        edgeHash = other.edgeHash;
     }
     return *this;
 }
@@ -38,11 +40,20 @@ void Graph::addEdge(int u, int v) {
         return; // Edge already exists
     }
     
+    addNewEdge(u, v);
+}
+
+void Graph::addNewEdge(int u, int v) {
+    if (!isValidVertex(u) || !isValidVertex(v)) {
+        throw std::invalid_argument("Invalid vertex index");
+    }
+    
     adjList[u].push_back(v);
     
     if (!directed && u != v) { // Avoid self-loop duplication in undirected graphs
         adjList[v].push_back(u);
     }
+    edgeHash ^= edgeKey(u, v);
 }
 
 // Remove edge
@@ -51,11 +62,29 @@ void Graph::removeEdge(int u, int v) {
         return;
     }
     
+    size_t before = adjList[u].size();
     adjList[u].remove(v);
+    if (adjList[u].size() == before) {
+        return; // No such edge
+    }
     
     if (!directed) {
         adjList[v].remove(u);
     }
+    edgeHash ^= edgeKey(u, v);
+}
+
+// Key of one edge for the Zobrist hash: splitmix64 of the endpoints,
+// ordered for undirected graphs so both directions share a key
+uint64_t Graph::edgeKey(int u, int v) const {
+    if (!directed && u > v) {
+        std::swap(u, v);
+    }
+    uint64_t x = (static_cast<uint64_t>(static_cast<uint32_t>(u)) << 32) | static_cast<uint32_t>(v);
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
 }
 
 // Get neighbors
@@ -191,13 +220,77 @@ bool Graph::isConnected() const {
     return true;
 }
 
-// DFS utility
+int Graph::getStronglyConnectedComponents(std::vector<int>& componentOf) const {
+    componentOf.assign(vertices, -1);
+    std::vector<int> index(vertices, -1);
+    std::vector<int> lowLink(vertices, 0);
+    std::vector<bool> onStack(vertices, false);
+    std::vector<int> stack;
+    // DFS frames: a vertex and its next out-edge to follow
+    std::vector<std::pair<int, std::list<int>::const_iterator>> frames;
+    int nextIndex = 0;
+    int count = 0;
+    
+    auto visit = [&](int v) {
+        index[v] = lowLink[v] = nextIndex++;
+        stack.push_back(v);
+        onStack[v] = true;
+        frames.push_back({v, adjList[v].begin()});
+    };
+    
+    for (int root = 0; root < vertices; ++root) {
+        if (index[root] >= 0) continue;
+        visit(root);
+        
+        while (!frames.empty()) {
+            int v = frames.back().first;
+            if (frames.back().second != adjList[v].end()) {
+                int w = *frames.back().second++;
+                if (index[w] < 0) {
+                    visit(w);
+                } else if (onStack[w]) {
+                    lowLink[v] = std::min(lowLink[v], index[w]);
+                }
+                continue;
+            }
+            
+            // All edges of v done: v roots a component if nothing below it
+            // reached further up
+            frames.pop_back();
+            if (lowLink[v] == index[v]) {
+                int w;
+                do {
+                    w = stack.back();
+                    stack.pop_back();
+                    onStack[w] = false;
+                    componentOf[w] = count;
+                } while (w != v);
+                count++;
+            }
+            if (!frames.empty()) {
+                int parent = frames.back().first;
+                lowLink[parent] = std::min(lowLink[parent], lowLink[v]);
+            }
+        }
+    }
+    
+    return count;
+}
+
+// DFS utility, with an explicit stack so long paths cannot overflow the
+// call stack
 void Graph::dfsUtil(int v, std::vector<bool>& visited) const {
+    std::vector<int> stack{v};
     visited[v] = true;
     
-    for (int neighbor : adjList[v]) {
-        if (!visited[neighbor]) {
-            dfsUtil(neighbor, visited);
+    while (!stack.empty()) {
+        int current = stack.back();
+        stack.pop_back();
+        for (int neighbor : adjList[current]) {
+            if (!visited[neighbor]) {
+                visited[neighbor] = true;
+                stack.push_back(neighbor);
+            }
         }
     }
 }
@@ -209,9 +302,17 @@ bool Graph::hasEulerCircuit() const {
     }
     
     if (directed) {
-        // For directed graphs: in-degree = out-degree for all vertices
+        // For directed graphs: in-degree = out-degree for all vertices,
+        // counted in one pass over the edges
+        std::vector<int> balance(vertices, 0);
         for (int i = 0; i < vertices; ++i) {
-            if (getInDegree(i) != getOutDegree(i)) {
+            balance[i] += adjList[i].size();
+            for (int neighbor : adjList[i]) {
+                balance[neighbor]--;
+            }
+        }
+        for (int i = 0; i < vertices; ++i) {
+            if (balance[i] != 0) {
                 return false;
             }
         }
@@ -230,6 +331,31 @@ bool Graph::hasEulerCircuit() const {
 bool Graph::isEulerianConnected() const {
     if (vertices == 0) return false;
     
+    if (directed) {
+        // Every vertex with an edge, in or out, must lie in a single
+        // strongly connected component
+        std::vector<bool> hasEdges(vertices, false);
+        for (int i = 0; i < vertices; ++i) {
+            for (int neighbor : adjList[i]) {
+                hasEdges[i] = true;
+                hasEdges[neighbor] = true;
+            }
+        }
+        
+        std::vector<int> componentOf;
+        getStronglyConnectedComponents(componentOf);
+        int component = -1;
+        for (int i = 0; i < vertices; ++i) {
+            if (!hasEdges[i]) continue;
+            if (component < 0) {
+                component = componentOf[i];
+            } else if (componentOf[i] != component) {
+                return false;
+            }
+        }
+        return component >= 0;
+    }
+    
     // Create a copy of the graph to check connectivity
     // only considering vertices with non-zero degree
     std::vector<bool> hasEdges(vertices, false);
@@ -327,6 +453,7 @@ void Graph::clear() {
     for (auto& list : adjList) {
         list.clear();
     }
+    edgeHash = 0;
 }
 
 std::vector<std::pair<int, int>> Graph::getAllEdges() const {
@@ -6,12 +6,14 @@
 #include <iostream>
 #include <stdexcept>
 #include <algorithm>
+#include <cstdint>
 
 class Graph {
 private:
     int vertices;
     bool directed;
     std::vector<std::list<int>> adjList;
+    uint64_t edgeHash;   // XOR of edgeKey over the current edges
     
 public:
     // Constructors
@@ -22,6 +24,9 @@ public:
     
     // Basic operations
     void addEdge(int u, int v);
+    // Same as addEdge for an edge the caller knows is not there yet, without
+    // the O(degree) duplicate check; for generators of distinct pairs
+    void addNewEdge(int u, int v);
     void removeEdge(int u, int v);
     std::vector<int> getNeighbors(int vertex) const;
     
@@ -29,6 +34,13 @@ public:
     int getVertexCount() const { return vertices; }
     bool isDirected() const { return directed; }
     
+    // Zobrist hash of the edge set, kept up to date by addEdge, removeEdge
+    // and clear: the XOR of a pseudo-random 64-bit key per edge. It does not
+    // depend on the order edges were added in, and it is the same in every
+    // process, so equal edge sets (with equal vertex counts and
+    // directedness) always hash equal
+    uint64_t getHash() const { return edgeHash; }
+    
     // Display
     void printGraph() const;
     std::string getGraphString() const;
@@ -44,6 +56,10 @@ public:
     bool isEmpty() const;
     int getEdgeCount() const;
     bool isConnected() const;
+    // Tarjan's algorithm with an explicit stack, O(V + E) and safe on long
+    // paths. Fills componentOf for every vertex and returns the number of
+    // components; for undirected graphs these are the connected components
+    int getStronglyConnectedComponents(std::vector<int>& componentOf) const;
     
     // Euler circuit methods
     bool hasEulerCircuit() const;
@@ -55,6 +71,7 @@ public:
     Graph getUndirectedCopy() const;
     
 private:
+    uint64_t edgeKey(int u, int v) const;
     void dfsUtil(int v, std::vector<bool>& visited) const;
     void hierholzerAlgorithm(std::vector<int>& circuit);
     bool isEulerianConnected() const;
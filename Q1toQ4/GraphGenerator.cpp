@@ -1,7 +1,362 @@
 #include "GraphGenerator.h"
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
 #include <set>
 #include <stdexcept>
+#include <thread>
+
+namespace {
+
+// Uniform double in (0, 1); never returns 0 so it is safe to take the log
+double uniformOpen(std::mt19937& gen) {
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    double u;
+    do {
+        u = dist(gen);
+    } while (u <= 0.0);
+    return u;
+}
+
+// Vitter's sequential sampling (Method D with Method A fallback): selects
+// exactly n distinct indices from [0, N) uniformly at random and hands them
+// to emit in increasing order. Expected O(n) time and O(1) memory.
+template <typename Emit>
+void sequentialSample(std::mt19937& gen, uint64_t n, uint64_t N, Emit emit) {
+    uint64_t current = 0;
+    auto select = [&](uint64_t skip) {
+        current += skip;
+        emit(current);
+        current++;
+    };
+
+    // Method A: O(N) but cheap per step, used when n is a large fraction of N
+    auto methodA = [&](uint64_t n, uint64_t N) {
+        double top = static_cast<double>(N - n);
+        double Nreal = static_cast<double>(N);
+        while (n >= 2) {
+            double V = uniformOpen(gen);
+            uint64_t S = 0;
+            double quot = top / Nreal;
+            while (quot > V) {
+                S++;
+                top -= 1.0;
+                Nreal -= 1.0;
+                quot = quot * top / Nreal;
+            }
+            select(S);
+            Nreal -= 1.0;
+            n--;
+        }
+        if (n == 1) {
+            select(static_cast<uint64_t>(std::floor(std::round(Nreal) * uniformOpen(gen))));
+        }
+    };
+
+    const double alphaInv = 13.0;
+    if (n == 0) return;
+    if (static_cast<double>(n) * alphaInv >= static_cast<double>(N)) {
+        methodA(n, N);
+        return;
+    }
+
+    double nreal = static_cast<double>(n);
+    double ninv = 1.0 / nreal;
+    double Nreal = static_cast<double>(N);
+    double Vprime = std::exp(std::log(uniformOpen(gen)) * ninv);
+    uint64_t qu1 = N - n + 1;
+    double qu1real = Nreal - nreal + 1.0;
+    double threshold = alphaInv * nreal;
+
+    while (n > 1 && threshold < Nreal) {
+        double nmin1inv = 1.0 / (nreal - 1.0);
+        uint64_t S;
+        double negSreal;
+
+        while (true) {
+            double X;
+            while (true) {
+                X = Nreal * (1.0 - Vprime);
+                S = static_cast<uint64_t>(X);
+                if (S < qu1) break;
+                Vprime = std::exp(std::log(uniformOpen(gen)) * ninv);
+            }
+
+            double U = uniformOpen(gen);
+            negSreal = -static_cast<double>(S);
+            double y1 = std::exp(std::log(U * Nreal / qu1real) * nmin1inv);
+            Vprime = y1 * (1.0 - X / Nreal) * (qu1real / (negSreal + qu1real));
+            if (Vprime <= 1.0) break; // Accepted by the cheap test
+
+            double y2 = 1.0;
+            double top = Nreal - 1.0;
+            double bottom;
+            uint64_t limit;
+            if (n - 1 > S) {
+                bottom = Nreal - nreal;
+                limit = N - S;
+            } else {
+                bottom = Nreal + negSreal - 1.0;
+                limit = qu1;
+            }
+            for (uint64_t t = N - 1; t >= limit; t--) {
+                y2 = (y2 * top) / bottom;
+                top -= 1.0;
+                bottom -= 1.0;
+            }
+
+            if (Nreal / (Nreal - X) >= y1 * std::exp(std::log(y2) * nmin1inv)) {
+                Vprime = std::exp(std::log(uniformOpen(gen)) * nmin1inv);
+                break; // Accepted by the exact test
+            }
+            Vprime = std::exp(std::log(uniformOpen(gen)) * ninv);
+        }
+
+        select(S);
+        N = N - S - 1;
+        Nreal = Nreal + negSreal - 1.0;
+        n--;
+        nreal -= 1.0;
+        ninv = nmin1inv;
+        qu1 -= S;
+        qu1real += negSreal;
+        threshold -= alphaInv;
+    }
+
+    if (n > 1) {
+        methodA(n, N);
+    } else if (n == 1) {
+        select(static_cast<uint64_t>(Nreal * Vprime));
+    }
+}
+
+// Bernoulli sampling of [0, N) with probability p using geometric skips
+// (Batagelj-Brandes), so the cost is proportional to the number selected.
+template <typename Emit>
+void geometricSample(std::mt19937& gen, double p, uint64_t N, Emit emit) {
+    if (p <= 0.0 || N == 0) return;
+    if (p >= 1.0) {
+        for (uint64_t i = 0; i < N; i++) emit(i);
+        return;
+    }
+
+    double logq = std::log(1.0 - p);
+    uint64_t index = 0;
+    while (index < N) {
+        double skip = std::floor(std::log(uniformOpen(gen)) / logq);
+        if (skip >= static_cast<double>(N - index)) break;
+        index += static_cast<uint64_t>(skip);
+        emit(index);
+        index++;
+    }
+}
+
+// Maps increasing candidate-edge indices back to (u, v). Candidate edges are
+// numbered row by row: row u holds the pairs (u, v) with v != u (directed)
+// or v > u (undirected).
+class PairDecoder {
+private:
+    bool directed;
+    int u;
+    uint64_t rowStart;
+    uint64_t rowLength;
+
+public:
+    PairDecoder(int vertices, bool isDirected)
+        : directed(isDirected), u(0), rowStart(0),
+          rowLength(static_cast<uint64_t>(vertices - 1)) {}
+
+    std::pair<int, int> decode(uint64_t index) {
+        while (index >= rowStart + rowLength) {
+            rowStart += rowLength;
+            u++;
+            if (!directed) rowLength--;
+        }
+
+        uint64_t offset = index - rowStart;
+        if (directed) {
+            return {u, static_cast<int>(offset >= static_cast<uint64_t>(u) ? offset + 1 : offset)};
+        }
+        return {u, u + 1 + static_cast<int>(offset)};
+    }
+};
+
+// Open-addressing set of 64-bit edge keys for the rejection samplers;
+// one flat array, so lookups cost a single cache miss on average
+class EdgeKeySet {
+private:
+    static constexpr uint64_t EMPTY = ~0ULL;
+    std::vector<uint64_t> slots;
+    uint64_t mask;
+
+public:
+    explicit EdgeKeySet(size_t expectedKeys) {
+        size_t capacity = 16;
+        while (capacity < expectedKeys * 2) capacity <<= 1;
+        slots.assign(capacity, EMPTY);
+        mask = capacity - 1;
+    }
+
+    // Returns true if the key was not present before
+    bool insert(uint64_t key) {
+        uint64_t slot = ((key * 0x9E3779B97F4A7C15ULL) >> 17) & mask;
+        while (slots[slot] != EMPTY) {
+            if (slots[slot] == key) return false;
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = key;
+        return true;
+    }
+};
+
+// Runs body(i) for every i in [first, last) on all hardware threads, which
+// claim chunks of 64 indices from a shared counter
+template <typename Body>
+void parallelFor(int first, int last, Body body) {
+    int count = last - first;
+    if (count <= 0) return;
+    unsigned int workerCount = std::max(1u, std::thread::hardware_concurrency());
+    workerCount = std::min<unsigned int>(workerCount, static_cast<unsigned int>((count + 63) / 64));
+    std::atomic<int> next(first);
+    auto worker = [&]() {
+        const int chunk = 64;
+        int i;
+        while ((i = next.fetch_add(chunk)) < last) {
+            int end = std::min(last, i + chunk);
+            for (; i < end; ++i) {
+                body(i);
+            }
+        }
+    };
+    
+    std::vector<std::thread> workers;
+    for (unsigned int t = 1; t < workerCount; ++t) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : workers) {
+        thread.join();
+    }
+}
+
+// Points of a random geometric graph bucketed into a square grid. Cells are
+// at least radius wide, so every neighbor lies in the same or an adjacent
+// cell; the grid is capped near sqrt(n) per side to bound the number of
+// empty cells for tiny radii.
+class GeometricGrid {
+public:
+    // Cells scanned in parallel per call of the visitor in forEachCell
+    static constexpr int BLOCK_CELLS = 4096;
+    
+    GeometricGrid(const std::vector<double>& xs, const std::vector<double>& ys, double radius)
+        : xs(xs), ys(ys), radiusSquared(radius * radius) {
+        int vertices = static_cast<int>(xs.size());
+        side = static_cast<int>(std::floor(1.0 / radius));
+        side = std::max(1, std::min(side, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(vertices))))));
+        cells = side * side;
+        
+        // Counting sort of the points into cells
+        cellStart.assign(cells + 1, 0);
+        for (int i = 0; i < vertices; ++i) {
+            cellStart[cellOf(i) + 1]++;
+        }
+        for (int c = 0; c < cells; ++c) {
+            cellStart[c + 1] += cellStart[c];
+        }
+        cellPoints.resize(vertices);
+        std::vector<int> fill(cellStart.begin(), cellStart.end() - 1);
+        for (int i = 0; i < vertices; ++i) {
+            cellPoints[fill[cellOf(i)]++] = i;
+        }
+    }
+    
+    long long countEdges() const {
+        std::vector<int> counts(cells, 0);
+        parallelFor(0, cells, [&](int c) {
+            scanCell(c, [&](int, int, double) { counts[c]++; });
+        });
+        long long total = 0;
+        for (int count : counts) {
+            total += count;
+        }
+        return total;
+    }
+    
+    // Calls visit(edges) for every cell in order, with the edges found there.
+    // Blocks of cells are scanned in parallel, so only one block's edges are
+    // held at a time and the order does not depend on the thread count.
+    template <typename Visit>
+    void forEachCell(Visit visit) const {
+        std::vector<std::vector<WeightedEdge>> cellEdges(std::min(cells, BLOCK_CELLS));
+        for (int first = 0; first < cells; first += BLOCK_CELLS) {
+            int last = std::min(cells, first + BLOCK_CELLS);
+            parallelFor(first, last, [&](int c) {
+                std::vector<WeightedEdge>& out = cellEdges[c - first];
+                out.clear();
+                scanCell(c, [&out](int u, int v, double weight) {
+                    out.push_back({u, v, weight});
+                });
+            });
+            for (int c = first; c < last; ++c) {
+                visit(static_cast<const std::vector<WeightedEdge>&>(cellEdges[c - first]));
+            }
+        }
+    }
+    
+private:
+    const std::vector<double>& xs;
+    const std::vector<double>& ys;
+    double radiusSquared;
+    int side;
+    int cells;
+    std::vector<int> cellStart;
+    std::vector<int> cellPoints;
+    
+    int cellOf(int i) const {
+        int cx = std::min(side - 1, static_cast<int>(xs[i] * side));
+        int cy = std::min(side - 1, static_cast<int>(ys[i] * side));
+        return cy * side + cx;
+    }
+    
+    // Calls emit(u, v, length) with u < v for every edge found in cell c.
+    // Each cell is paired with itself and its four "forward" neighbors, so
+    // every unordered pair of cells is visited exactly once.
+    template <typename Emit>
+    void scanCell(int c, Emit emit) const {
+        static const int forward[4][2] = {{1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+        int cx = c % side;
+        int cy = c / side;
+        
+        auto tryPair = [&](int a, int b) {
+            double dx = xs[a] - xs[b];
+            double dy = ys[a] - ys[b];
+            double d2 = dx * dx + dy * dy;
+            if (d2 <= radiusSquared) {
+                emit(std::min(a, b), std::max(a, b), std::sqrt(d2));
+            }
+        };
+        
+        for (int i = cellStart[c]; i < cellStart[c + 1]; ++i) {
+            for (int j = i + 1; j < cellStart[c + 1]; ++j) {
+                tryPair(cellPoints[i], cellPoints[j]);
+            }
+        }
+        for (const auto& offset : forward) {
+            int nx = cx + offset[0];
+            int ny = cy + offset[1];
+            if (nx < 0 || nx >= side || ny >= side) continue;
+            int n = ny * side + nx;
+            for (int i = cellStart[c]; i < cellStart[c + 1]; ++i) {
+                for (int j = cellStart[n]; j < cellStart[n + 1]; ++j) {
+                    tryPair(cellPoints[i], cellPoints[j]);
+                }
+            }
+        }
+    }
+};
+
+} // namespace
 
 GraphGenerator::GraphGenerator(unsigned int seed) : generator(seed) {}
 
@@ -9,17 +364,18 @@ void GraphGenerator::setSeed(unsigned int seed) {
     generator.seed(seed);
 }
 
-int GraphGenerator::getMaxEdges(int vertices, bool directed) {
+long long GraphGenerator::getMaxEdges(int vertices, bool directed) {
     if (vertices <= 1) return 0;
     
+    long long n = vertices;
     if (directed) {
-        return vertices * (vertices - 1); // n(n-1) for directed
+        return n * (n - 1); // n(n-1) for directed
     } else {
-        return vertices * (vertices - 1) / 2; // n(n-1)/2 for undirected
+        return n * (n - 1) / 2; // n(n-1)/2 for undirected
     }
 }
 
-bool GraphGenerator::isValidEdgeCount(int vertices, int edges, bool directed) {
+bool GraphGenerator::isValidEdgeCount(int vertices, long long edges, bool directed) {
     if (vertices <= 0 || edges < 0) return false;
     return edges <= getMaxEdges(vertices, directed);
 }
@@ -60,6 +416,24 @@ Graph GraphGenerator::generateRandomGraph(int vertices, int edges, bool directed
     return graph;
 }
 
+void GraphGenerator::streamRandomGraph(int vertices, long long edges, bool directed, GraphSink& sink) {
+    if (!isValidEdgeCount(vertices, edges, directed)) {
+        throw std::invalid_argument("Invalid edge count for given vertices");
+    }
+    
+    sink.begin(vertices, edges, directed, false);
+    
+    PairDecoder decoder(vertices, directed);
+    sequentialSample(generator, static_cast<uint64_t>(edges),
+                     static_cast<uint64_t>(getMaxEdges(vertices, directed)),
+                     [&](uint64_t index) {
+        std::pair<int, int> edge = decoder.decode(index);
+        sink.addEdge(edge.first, edge.second);
+    });
+    
+    sink.end();
+}
+
 Graph GraphGenerator::generateConnectedGraph(int vertices, int edges, bool directed) {
     if (vertices <= 1) {
         return Graph(vertices, directed);
@@ -80,34 +454,71 @@ Graph GraphGenerator::generateConnectedGraph(int vertices, int edges, bool direc
     
     std::shuffle(vertices_list.begin(), vertices_list.end(), generator);
     
-    // Connect vertices in a random tree
+    // Connect vertices in a random tree, remembering its edges so the extra
+    // edges below never need to query the adjacency lists. Every pair added
+    // here and below is new, so none pays addEdge's O(degree) duplicate check
+    std::vector<std::pair<int, int>> treeEdges;
+    treeEdges.reserve(vertices - 1);
     for (int i = 1; i < vertices; ++i) {
         std::uniform_int_distribution<int> dist(0, i - 1);
         int parent = dist(generator);
-        graph.addEdge(vertices_list[parent], vertices_list[i]);
+        graph.addNewEdge(vertices_list[parent], vertices_list[i]);
+        treeEdges.push_back({vertices_list[parent], vertices_list[i]});
     }
     
     // Add remaining edges randomly
-    int remainingEdges = edges - minEdges;
-    std::vector<std::pair<int, int>> possibleEdges;
+    long long remainingEdges = static_cast<long long>(edges) - minEdges;
+    if (remainingEdges <= 0) {
+        return graph;
+    }
     
-    // Generate all possible additional edges
-    for (int i = 0; i < vertices; ++i) {
-        for (int j = 0; j < vertices; ++j) {
-            if (i != j && !graph.hasEdge(i, j)) {
-                if (directed) {
-                    possibleEdges.push_back({i, j});
-                } else if (i < j) {
+    long long n = vertices;
+    auto edgeKey = [&](int u, int v) {
+        if (!directed && u > v) std::swap(u, v);
+        return static_cast<uint64_t>(u) * static_cast<uint64_t>(n) + static_cast<uint64_t>(v);
+    };
+    
+    if (2LL * edges > getMaxEdges(vertices, directed)) {
+        // Dense: V^2 = O(E) here, so enumerating the free pairs is linear in the output
+        std::vector<bool> used(static_cast<size_t>(n * n), false);
+        for (const auto& edge : treeEdges) {
+            used[edgeKey(edge.first, edge.second)] = true;
+        }
+        
+        std::vector<std::pair<int, int>> possibleEdges;
+        for (int i = 0; i < vertices; ++i) {
+            for (int j = directed ? 0 : i + 1; j < vertices; ++j) {
+                if (i != j && !used[edgeKey(i, j)]) {
                     possibleEdges.push_back({i, j});
                 }
             }
         }
-    }
-    
-    std::shuffle(possibleEdges.begin(), possibleEdges.end(), generator);
-    
-    for (int i = 0; i < remainingEdges && i < static_cast<int>(possibleEdges.size()); ++i) {
-        graph.addEdge(possibleEdges[i].first, possibleEdges[i].second);
+        
+        std::shuffle(possibleEdges.begin(), possibleEdges.end(), generator);
+        
+        long long available = static_cast<long long>(possibleEdges.size());
+        for (long long i = 0; i < remainingEdges && i < available; ++i) {
+            graph.addNewEdge(possibleEdges[i].first, possibleEdges[i].second);
+        }
+    } else {
+        // Sparse: rejection sampling against a hash set of taken pairs. At most half of all
+        // pairs are taken, so each draw succeeds with probability >= 1/2 and
+        // the expected total work is O(E).
+        EdgeKeySet used(static_cast<size_t>(edges));
+        for (const auto& edge : treeEdges) {
+            used.insert(edgeKey(edge.first, edge.second));
+        }
+        
+        std::uniform_int_distribution<int> vertexDist(0, vertices - 1);
+        while (remainingEdges > 0) {
+            int u = vertexDist(generator);
+            int v = vertexDist(generator);
+            if (u == v || !used.insert(edgeKey(u, v))) {
+                continue;
+            }
+            graph.addNewEdge(u, v);
+            remainingEdges--;
+        }
     }
     
     return graph;
@@ -257,6 +668,207 @@ Graph GraphGenerator::generateEulerianGraph(int vertices, int edges, bool direct
     return graph;
 }
 
+Graph GraphGenerator::generateGnpGraph(int vertices, double edgeProbability, bool directed) {
+    if (edgeProbability < 0.0 || edgeProbability > 1.0) {
+        throw std::invalid_argument("Edge probability must be in [0, 1]");
+    }
+    
+    Graph graph(vertices, directed);
+    PairDecoder decoder(vertices, directed);
+    geometricSample(generator, edgeProbability,
+                    static_cast<uint64_t>(getMaxEdges(vertices, directed)),
+                    [&](uint64_t index) {
+        // Every index is drawn once, so the pairs are distinct
+        std::pair<int, int> edge = decoder.decode(index);
+        graph.addNewEdge(edge.first, edge.second);
+    });
+    
+    return graph;
+}
+
+void GraphGenerator::placeGeometricPoints(int vertices, double radius,
+                                          std::vector<double>& xs, std::vector<double>& ys) {
+    if (vertices <= 0) {
+        throw std::invalid_argument("Number of vertices must be positive");
+    }
+    if (radius <= 0.0 || radius > std::sqrt(2.0)) {
+        throw std::invalid_argument("Radius must be in (0, sqrt(2)]");
+    }
+    
+    // Points come from the seeded generator in vertex order, so the graph is
+    // a pure function of the seed no matter how many threads scan the grid
+    std::uniform_real_distribution<double> coord(0.0, 1.0);
+    xs.resize(vertices);
+    ys.resize(vertices);
+    for (int i = 0; i < vertices; ++i) {
+        xs[i] = coord(generator);
+        ys[i] = coord(generator);
+    }
+}
+
+Graph GraphGenerator::generateGeometricGraph(int vertices, double radius,
+                                             std::vector<WeightedEdge>* weightedEdges) {
+    std::vector<double> xs, ys;
+    placeGeometricPoints(vertices, radius, xs, ys);
+    GeometricGrid grid(xs, ys, radius);
+    
+    Graph graph(vertices, false);
+    if (weightedEdges) {
+        weightedEdges->clear();
+    }
+    grid.forEachCell([&](const std::vector<WeightedEdge>& edges) {
+        for (const auto& edge : edges) {
+            // The grid meets every pair of points once
+            graph.addNewEdge(edge.u, edge.v);
+        }
+        if (weightedEdges) {
+            weightedEdges->insert(weightedEdges->end(), edges.begin(), edges.end());
+        }
+    });
+    return graph;
+}
+
+void GraphGenerator::streamGeometricGraph(int vertices, double radius, bool withWeights, GraphSink& sink) {
+    std::vector<double> xs, ys;
+    placeGeometricPoints(vertices, radius, xs, ys);
+    GeometricGrid grid(xs, ys, radius);
+    
+    // The sink needs the edge count up front, so the grid is scanned twice:
+    // once to count, once to write cell by cell
+    sink.begin(vertices, grid.countEdges(), false, withWeights);
+    grid.forEachCell([&](const std::vector<WeightedEdge>& edges) {
+        for (const auto& edge : edges) {
+            if (withWeights) {
+                sink.addWeightedEdge(edge.u, edge.v, edge.weight);
+            } else {
+                sink.addEdge(edge.u, edge.v);
+            }
+        }
+    });
+    sink.end();
+}
+
+PlantedInstance GraphGenerator::generatePlantedClique(int vertices, double edgeProbability, int cliqueSize) {
+    if (cliqueSize < 1 || cliqueSize > vertices) {
+        throw std::invalid_argument("Clique size must be between 1 and the number of vertices");
+    }
+    
+    PlantedInstance instance(generateGnpGraph(vertices, edgeProbability, false));
+    
+    std::vector<int> order(vertices);
+    for (int i = 0; i < vertices; ++i) {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), generator);
+    
+    instance.witness.assign(order.begin(), order.begin() + cliqueSize);
+    std::sort(instance.witness.begin(), instance.witness.end());
+    
+    for (int i = 0; i < cliqueSize; ++i) {
+        for (int j = i + 1; j < cliqueSize; ++j) {
+            instance.graph.addEdge(instance.witness[i], instance.witness[j]);
+        }
+    }
+    
+    instance.cliqueLowerBound = cliqueSize;
+    instance.hamiltonian = false; // Unknown
+    return instance;
+}
+
+PlantedInstance GraphGenerator::generatePlantedHamiltonCycle(int vertices, double edgeProbability, bool directed) {
+    if (vertices < 3) {
+        throw std::invalid_argument("Hamilton cycle needs at least 3 vertices");
+    }
+    
+    PlantedInstance instance(generateGnpGraph(vertices, edgeProbability, directed));
+    
+    std::vector<int> cycle(vertices);
+    for (int i = 0; i < vertices; ++i) {
+        cycle[i] = i;
+    }
+    std::shuffle(cycle.begin(), cycle.end(), generator);
+    
+    for (int i = 0; i < vertices; ++i) {
+        instance.graph.addEdge(cycle[i], cycle[(i + 1) % vertices]);
+    }
+    
+    instance.witness = cycle;
+    instance.cliqueLowerBound = directed ? 0 : 2;
+    instance.hamiltonian = true;
+    return instance;
+}
+
+PlantedInstance GraphGenerator::generateNearThresholdClique(int vertices) {
+    // A clique one larger than G(n, 1/2) naturally contains is the hardest
+    // regime to find and to prove optimal
+    const double p = 0.5;
+    int cliqueSize = std::min(vertices, expectedCliqueNumber(vertices, p) + 1);
+    return generatePlantedClique(vertices, p, cliqueSize);
+}
+
+PlantedInstance GraphGenerator::generateNearThresholdHamilton(int vertices, bool directed) {
+    // Background noise right at the Hamiltonicity threshold leaves many long
+    // dead-end paths for a backtracking search to explore
+    return generatePlantedHamiltonCycle(vertices, hamiltonThreshold(vertices), directed);
+}
+
+int GraphGenerator::expectedCliqueNumber(int vertices, double edgeProbability) {
+    if (vertices <= 0) return 0;
+    if (edgeProbability <= 0.0) return 1;
+    if (edgeProbability >= 1.0) return vertices;
+    
+    // Largest k whose expected number of k-cliques, C(n,k) p^(k(k-1)/2), is at least 1
+    double logP = std::log(edgeProbability);
+    double n = vertices;
+    int best = 1;
+    for (int k = 2; k <= vertices; ++k) {
+        double logChoose = std::lgamma(n + 1) - std::lgamma(k + 1.0) - std::lgamma(n - k + 1);
+        double logExpected = logChoose + logP * k * (k - 1) / 2.0;
+        if (logExpected < 0.0) break;
+        best = k;
+    }
+    return best;
+}
+
+double GraphGenerator::hamiltonThreshold(int vertices) {
+    if (vertices < 3) return 1.0;
+    double n = vertices;
+    double p = (std::log(n) + std::log(std::log(n))) / n;
+    return std::min(1.0, std::max(0.0, p));
+}
+
+bool GraphGenerator::isClique(const Graph& graph, const std::vector<int>& vertices) {
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        if (!graph.isValidVertex(vertices[i])) return false;
+        for (size_t j = i + 1; j < vertices.size(); ++j) {
+            if (vertices[i] == vertices[j] || !graph.hasEdge(vertices[i], vertices[j])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool GraphGenerator::isHamiltonCycle(const Graph& graph, const std::vector<int>& cycle) {
+    int n = graph.getVertexCount();
+    
+    // Accept the cycle with or without the start vertex repeated at the end
+    size_t length = cycle.size();
+    if (length == static_cast<size_t>(n) + 1 && cycle.front() == cycle.back()) {
+        length--;
+    }
+    if (length != static_cast<size_t>(n) || n < 3) return false;
+    
+    std::vector<bool> seen(n, false);
+    for (size_t i = 0; i < length; ++i) {
+        int v = cycle[i];
+        if (!graph.isValidVertex(v) || seen[v]) return false;
+        seen[v] = true;
+        if (!graph.hasEdge(v, cycle[(i + 1) % length])) return false;
+    }
+    return true;
+}
+
 std::pair<int, int> GraphGenerator::generateRandomEdge(int vertices, const std::vector<std::pair<int, int>>& existing) {
     std::uniform_int_distribution<int> dist(0, vertices - 1);
     
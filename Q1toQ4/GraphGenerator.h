@@ -2,8 +2,25 @@
 #define GRAPH_GENERATOR_H
 
 #include "Graph.h"
+#include "GraphSink.h"
 #include <random>
 
+struct WeightedEdge {
+    int u, v;
+    double weight;
+};
+
+// Generated graph with a known answer, so benchmarks of the exponential
+// algorithms can check correctness as well as speed
+struct PlantedInstance {
+    Graph graph;
+    std::vector<int> witness;   // Planted clique members, or planted cycle in visiting order
+    int cliqueLowerBound;       // Maximum clique has at least this many vertices
+    bool hamiltonian;           // True when a Hamilton cycle is guaranteed to exist
+    
+    explicit PlantedInstance(const Graph& g) : graph(g), cliqueLowerBound(0), hamiltonian(false) {}
+};
+
 class GraphGenerator {
 private:
     std::mt19937 generator;
@@ -15,6 +32,10 @@ public:
     // Generate random graph
     Graph generateRandomGraph(int vertices, int edges, bool directed = false);
     
+    // Stream a uniformly random simple graph into a sink without materializing it.
+    // Memory is O(1) in the graph size; edges arrive sorted by (u, v).
+    void streamRandomGraph(int vertices, long long edges, bool directed, GraphSink& sink);
+    
     // Generate specific types of graphs
     Graph generateConnectedGraph(int vertices, int edges, bool directed = false);
     Graph generateCompleteGraph(int vertices, bool directed = false);
@@ -25,12 +46,39 @@ public:
     // Generate graph with Euler circuit guarantee
     Graph generateEulerianGraph(int vertices, int edges, bool directed = false);
     
+    // Erdos-Renyi G(n,p), O(n + m) using geometric skips
+    Graph generateGnpGraph(int vertices, double edgeProbability, bool directed = false);
+    
+    // Random geometric graph: points uniform in the unit square, joined when
+    // closer than radius. Grid bucketing gives O(n + m) expected time; cells
+    // are processed in parallel and the output depends only on the seed.
+    // weightedEdges, when given, receives every edge with its Euclidean length.
+    // The stream variant holds only one block of cells' edges at a time.
+    Graph generateGeometricGraph(int vertices, double radius,
+                                 std::vector<WeightedEdge>* weightedEdges = nullptr);
+    void streamGeometricGraph(int vertices, double radius, bool withWeights, GraphSink& sink);
+    
+    // Hardness-controlled instances with ground truth
+    PlantedInstance generatePlantedClique(int vertices, double edgeProbability, int cliqueSize);
+    PlantedInstance generatePlantedHamiltonCycle(int vertices, double edgeProbability, bool directed = false);
+    PlantedInstance generateNearThresholdClique(int vertices);
+    PlantedInstance generateNearThresholdHamilton(int vertices, bool directed = false);
+    
+    // Thresholds used by the near-threshold generators
+    static int expectedCliqueNumber(int vertices, double edgeProbability);
+    static double hamiltonThreshold(int vertices);
+    
+    // Ground-truth checks for algorithm output
+    static bool isClique(const Graph& graph, const std::vector<int>& vertices);
+    static bool isHamiltonCycle(const Graph& graph, const std::vector<int>& cycle);
+    
     // Utility methods
     void setSeed(unsigned int seed);
-    static int getMaxEdges(int vertices, bool directed);
-    static bool isValidEdgeCount(int vertices, int edges, bool directed);
+    static long long getMaxEdges(int vertices, bool directed);
+    static bool isValidEdgeCount(int vertices, long long edges, bool directed);
     
 private:
+    void placeGeometricPoints(int vertices, double radius, std::vector<double>& xs, std::vector<double>& ys);
     std::pair<int, int> generateRandomEdge(int vertices, const std::vector<std::pair<int, int>>& existing);
     bool hasEdge(const std::vector<std::pair<int, int>>& edges, int u, int v, bool directed);
 };
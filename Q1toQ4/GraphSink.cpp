@@ -0,0 +1,155 @@
+#include "GraphSink.h"
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+// GraphBuilderSink
+void GraphBuilderSink::begin(int vertices, long long, bool directed, bool) {
+    graph = std::make_unique<Graph>(vertices, directed);
+}
+
+void GraphBuilderSink::addEdge(int u, int v) {
+    if (!graph) {
+        throw std::logic_error("GraphBuilderSink: addEdge before begin");
+    }
+    graph->addEdge(u, v);
+}
+
+Graph GraphBuilderSink::takeGraph() {
+    if (!graph) {
+        throw std::logic_error("GraphBuilderSink: no graph was generated");
+    }
+    Graph result = *graph;
+    graph.reset();
+    return result;
+}
+
+// EdgeListFileSink
+EdgeListFileSink::EdgeListFileSink(const std::string& filePath)
+    : out(&std::cout), path(filePath), weighted(false), expectedEdges(0), writtenEdges(0) {
+    if (!path.empty() && path != "-") {
+        file.open(path, std::ios::out | std::ios::trunc);
+        if (!file) {
+            throw std::runtime_error("Cannot open output file: " + path);
+        }
+        out = &file;
+    }
+}
+
+void EdgeListFileSink::begin(int vertices, long long edges, bool directed, bool isWeighted) {
+    weighted = isWeighted;
+    expectedEdges = edges;
+    writtenEdges = 0;
+    *out << vertices << " " << edges << " " << (directed ? 1 : 0) << "\n";
+}
+
+void EdgeListFileSink::addEdge(int u, int v) {
+    if (weighted) {
+        addWeightedEdge(u, v, 1.0);
+        return;
+    }
+    *out << u << " " << v << "\n";
+    writtenEdges++;
+}
+
+void EdgeListFileSink::addWeightedEdge(int u, int v, double weight) {
+    if (!weighted) {
+        addEdge(u, v);
+        return;
+    }
+    *out << u << " " << v << " " << weight << "\n";
+    writtenEdges++;
+}
+
+void EdgeListFileSink::end() {
+    out->flush();
+    if (!*out) {
+        throw std::runtime_error("Write failed: " + (path.empty() ? std::string("stdout") : path));
+    }
+    if (writtenEdges != expectedEdges) {
+        throw std::runtime_error("Edge count mismatch: header says " + std::to_string(expectedEdges) +
+                                 ", wrote " + std::to_string(writtenEdges));
+    }
+}
+
+// BinaryEdgeFileSink
+BinaryEdgeFileSink::BinaryEdgeFileSink(const std::string& filePath)
+    : path(filePath), weighted(false), expectedEdges(0), writtenEdges(0) {
+    file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Cannot open output file: " + path);
+    }
+    buffer.reserve(3 * BUFFER_EDGES);
+}
+
+void BinaryEdgeFileSink::begin(int vertices, long long edges, bool directed, bool isWeighted) {
+    weighted = isWeighted;
+    expectedEdges = edges;
+    writtenEdges = 0;
+
+    const char magic[4] = {'G', 'R', 'P', 'H'};
+    uint32_t version = FORMAT_VERSION;
+    uint32_t flags = (directed ? 1u : 0u) | (weighted ? 2u : 0u);
+    uint32_t reserved = 0;
+    uint64_t vertexCount = static_cast<uint64_t>(vertices);
+    uint64_t edgeCount = static_cast<uint64_t>(edges);
+
+    file.write(magic, sizeof(magic));
+    file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    file.write(reinterpret_cast<const char*>(&flags), sizeof(flags));
+    file.write(reinterpret_cast<const char*>(&reserved), sizeof(reserved));
+    file.write(reinterpret_cast<const char*>(&vertexCount), sizeof(vertexCount));
+    file.write(reinterpret_cast<const char*>(&edgeCount), sizeof(edgeCount));
+}
+
+void BinaryEdgeFileSink::addEdge(int u, int v) {
+    if (weighted) {
+        addWeightedEdge(u, v, 1.0);
+        return;
+    }
+    buffer.push_back(static_cast<uint32_t>(u));
+    buffer.push_back(static_cast<uint32_t>(v));
+    writtenEdges++;
+
+    if (buffer.size() >= 2 * BUFFER_EDGES) {
+        flushBuffer();
+    }
+}
+
+void BinaryEdgeFileSink::addWeightedEdge(int u, int v, double weight) {
+    if (!weighted) {
+        addEdge(u, v);
+        return;
+    }
+    float w = static_cast<float>(weight);
+    uint32_t bits;
+    std::memcpy(&bits, &w, sizeof(bits));
+
+    buffer.push_back(static_cast<uint32_t>(u));
+    buffer.push_back(static_cast<uint32_t>(v));
+    buffer.push_back(bits);
+    writtenEdges++;
+
+    if (buffer.size() >= 3 * BUFFER_EDGES) {
+        flushBuffer();
+    }
+}
+
+void BinaryEdgeFileSink::flushBuffer() {
+    if (buffer.empty()) return;
+    file.write(reinterpret_cast<const char*>(buffer.data()),
+               static_cast<std::streamsize>(buffer.size() * sizeof(uint32_t)));
+    buffer.clear();
+}
+
+void BinaryEdgeFileSink::end() {
+    flushBuffer();
+    file.flush();
+    if (!file) {
+        throw std::runtime_error("Write failed: " + path);
+    }
+    if (writtenEdges != expectedEdges) {
+        throw std::runtime_error("Edge count mismatch: header says " + std::to_string(expectedEdges) +
+                                 ", wrote " + std::to_string(writtenEdges));
+    }
+}
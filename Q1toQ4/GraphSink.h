@@ -0,0 +1,90 @@
+#ifndef GRAPH_SINK_H
+#define GRAPH_SINK_H
+
+#include "Graph.h"
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Receives generated edges one at a time, so a generator never has to
+// hold the whole graph in memory.
+class GraphSink {
+public:
+    virtual ~GraphSink() = default;
+    virtual void begin(int vertices, long long edges, bool directed, bool weighted) = 0;
+    virtual void addEdge(int u, int v) = 0;
+    virtual void addWeightedEdge(int u, int v, double) { addEdge(u, v); }
+    virtual void end() = 0;
+};
+
+// Builds an in-memory Graph from the streamed edges (Graph is unweighted,
+// so edge weights are dropped)
+class GraphBuilderSink : public GraphSink {
+private:
+    std::unique_ptr<Graph> graph;
+
+public:
+    void begin(int vertices, long long edges, bool directed, bool weighted) override;
+    void addEdge(int u, int v) override;
+    void end() override {}
+
+    Graph takeGraph();
+};
+
+// Text edge list: "vertices edges directed" header, then one "u v" line per
+// edge ("u v weight" for weighted graphs)
+class EdgeListFileSink : public GraphSink {
+private:
+    std::ofstream file;
+    std::ostream* out;
+    std::string path;
+    bool weighted;
+    long long expectedEdges;
+    long long writtenEdges;
+
+public:
+    // An empty path or "-" writes to standard output
+    explicit EdgeListFileSink(const std::string& filePath);
+
+    void begin(int vertices, long long edges, bool directed, bool weighted) override;
+    void addEdge(int u, int v) override;
+    void addWeightedEdge(int u, int v, double weight) override;
+    void end() override;
+
+    long long getWrittenEdges() const { return writtenEdges; }
+};
+
+// Binary edge list:
+//   header: "GRPH" magic, uint32 version, uint32 flags (bit 0 = directed,
+//           bit 1 = weighted), uint32 reserved, uint64 vertices, uint64 edges
+//   body:   one (uint32 u, uint32 v) pair per edge, followed by a float32
+//           weight when weighted; native byte order
+class BinaryEdgeFileSink : public GraphSink {
+private:
+    std::ofstream file;
+    std::string path;
+    bool weighted;
+    std::vector<uint32_t> buffer;
+    long long expectedEdges;
+    long long writtenEdges;
+
+    static constexpr size_t BUFFER_EDGES = 1 << 15;
+
+    void flushBuffer();
+
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    explicit BinaryEdgeFileSink(const std::string& filePath);
+
+    void begin(int vertices, long long edges, bool directed, bool weighted) override;
+    void addEdge(int u, int v) override;
+    void addWeightedEdge(int u, int v, double weight) override;
+    void end() override;
+
+    long long getWrittenEdges() const { return writtenEdges; }
+};
+
+#endif // GRAPH_SINK_H
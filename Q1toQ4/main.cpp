@@ -4,22 +4,33 @@
 #include <getopt.h>
 #include <cstdlib>
 #include <chrono>
+#include <climits>
 #include <iomanip>
+#include <memory>
+#include <string>
 
 // Function prototypes
 void printUsage(const char* programName);
 void printGraphInfo(const Graph& graph);
 void printEulerResult(const Graph& graph);
 void runTests();
+int generateToSink(int vertices, long long edges, unsigned int seed, bool directed,
+                   double radius, bool weighted,
+                   const std::string& outPath, const std::string& format);
 
 int main(int argc, char* argv[]) {
     int vertices = -1;
-    int edges = -1;
+    long long edges = -1;
     unsigned int seed = 0;
     bool directed = false;
     bool runTestMode = false;
     bool verbose = false;
     bool seedProvided = false;
+    bool generateOnly = false;
+    std::string outPath;
+    std::string format = "text";
+    double radius = 0.0;
+    bool weighted = false;
     
     // getopt long options
     static struct option long_options[] = {
@@ -29,6 +40,11 @@ int main(int argc, char* argv[]) {
         {"directed",    no_argument,       0, 'd'},
         {"test",        no_argument,       0, 't'},
         {"verbose",     no_argument,       0, 'V'},
+        {"generate-only", no_argument,     0, 'g'},
+        {"out",         required_argument, 0, 'o'},
+        {"format",      required_argument, 0, 'f'},
+        {"radius",      required_argument, 0, 'r'},
+        {"weights",     no_argument,       0, 'w'},
         {"help",        no_argument,       0, 'h'},
         {0, 0, 0, 0}
     };
@@ -36,7 +52,7 @@ int main(int argc, char* argv[]) {
     int option_index = 0;
     int c;
     
-    while ((c = getopt_long(argc, argv, "v:e:s:dtVh", long_options, &option_index)) != -1) {
+    while ((c = getopt_long(argc, argv, "v:e:s:dtVgo:f:r:wh", long_options, &option_index)) != -1) {
         switch (c) {
             case 'v':
                 vertices = std::atoi(optarg);
@@ -47,7 +63,7 @@ int main(int argc, char* argv[]) {
                 break;
                 
             case 'e':
-                edges = std::atoi(optarg);
+                edges = std::atoll(optarg);
                 if (edges < 0) {
                     std::cerr << "Error: Number of edges must be non-negative\n";
                     return 1;
@@ -71,6 +87,34 @@ int main(int argc, char* argv[]) {
                 verbose = true;
                 break;
                 
+            case 'g':
+                generateOnly = true;
+                break;
+                
+            case 'o':
+                outPath = optarg;
+                break;
+                
+            case 'f':
+                format = optarg;
+                if (format != "text" && format != "binary") {
+                    std::cerr << "Error: Format must be 'text' or 'binary'\n";
+                    return 1;
+                }
+                break;
+                
+            case 'r':
+                radius = std::atof(optarg);
+                if (radius <= 0.0) {
+                    std::cerr << "Error: Radius must be positive\n";
+                    return 1;
+                }
+                break;
+                
+            case 'w':
+                weighted = true;
+                break;
+                
             case 'h':
                 printUsage(argv[0]);
                 return 0;
@@ -86,11 +130,17 @@ int main(int argc, char* argv[]) {
     
     // Validate required parameters
     if (!runTestMode) {
-        if (vertices == -1 || edges == -1 || !seedProvided) {
+        // A geometric graph's edge count follows from the radius
+        bool geometric = radius > 0.0;
+        if (vertices == -1 || (edges == -1 && !geometric) || !seedProvided) {
             std::cerr << "Error: Missing required parameters\n";
             std::cerr << "Usage: " << argv[0] << " -v <vertices> -e <edges> -s <seed>\n";
             return 1;
         }
+        if (geometric && directed) {
+            std::cerr << "Error: Geometric graphs are undirected\n";
+            return 1;
+        }
     }
     
     try {
@@ -100,21 +150,49 @@ int main(int argc, char* argv[]) {
             return 0;
         }
         
+        if (radius > 0.0) {
+            if (generateOnly || !outPath.empty()) {
+                return generateToSink(vertices, -1, seed, false, radius, weighted, outPath, format);
+            }
+            
+            std::cout << "Graph parameters: " << vertices << " vertices, radius=" << radius
+                      << ", seed=" << seed << " (geometric, undirected)\n";
+            
+            GraphGenerator generator(seed);
+            Graph graph = generator.generateGeometricGraph(vertices, radius);
+            printGraphInfo(graph);
+            if (verbose) {
+                std::cout << "\nAdjacency list:\n";
+                graph.printGraph();
+            }
+            printEulerResult(graph);
+            return 0;
+        }
+        
         // Validate edge count
         if (!GraphGenerator::isValidEdgeCount(vertices, edges, directed)) {
-            int maxEdges = GraphGenerator::getMaxEdges(vertices, directed);
+            long long maxEdges = GraphGenerator::getMaxEdges(vertices, directed);
             std::cerr << "Error: Too many edges. Maximum for " << vertices 
                      << " vertices (" << (directed ? "directed" : "undirected") 
                      << ") is " << maxEdges << "\n";
             return 1;
         }
         
+        if (generateOnly || !outPath.empty()) {
+            return generateToSink(vertices, edges, seed, directed, 0.0, false, outPath, format);
+        }
+        
+        if (edges > INT_MAX) {
+            std::cerr << "Error: Too many edges to analyze in memory; use --generate-only --out FILE\n";
+            return 1;
+        }
+        
         std::cout << "Graph parameters: " << vertices << " vertices, " 
                   << edges << " edges, seed=" << seed 
                   << " (" << (directed ? "directed" : "undirected") << ")\n";
         
         GraphGenerator generator(seed);
-        Graph graph = generator.generateRandomGraph(vertices, edges, directed);
+        Graph graph = generator.generateRandomGraph(vertices, static_cast<int>(edges), directed);
         
         printGraphInfo(graph);
         
@@ -143,9 +221,54 @@ void printUsage(const char* programName) {
     std::cout << "  -d, --directed      Directed graph\n";
     std::cout << "  -V, --verbose       Print adjacency list\n";
     std::cout << "  -t, --test          Run tests\n";
+    std::cout << "  -g, --generate-only Stream the edge list without building the graph\n";
+    std::cout << "  -o, --out FILE      Write the edge list to FILE ('-' for stdout)\n";
+    std::cout << "  -f, --format FMT    Edge list format: text (default) or binary\n";
+    std::cout << "  -r, --radius R      Random geometric graph with radius R (replaces -e)\n";
+    std::cout << "  -w, --weights       Write Euclidean edge weights (geometric graphs)\n";
     std::cout << "  -h, --help          Show help\n";
 }
 
+int generateToSink(int vertices, long long edges, unsigned int seed, bool directed,
+                   double radius, bool weighted,
+                   const std::string& outPath, const std::string& format) {
+    bool toStdout = outPath.empty() || outPath == "-";
+    if (format == "binary" && toStdout) {
+        std::cerr << "Error: Binary format requires --out FILE\n";
+        return 1;
+    }
+    
+    std::unique_ptr<BinaryEdgeFileSink> binarySink;
+    std::unique_ptr<EdgeListFileSink> textSink;
+    GraphSink* sink;
+    if (format == "binary") {
+        binarySink = std::make_unique<BinaryEdgeFileSink>(outPath);
+        sink = binarySink.get();
+    } else {
+        textSink = std::make_unique<EdgeListFileSink>(outPath);
+        sink = textSink.get();
+    }
+    
+    auto start = std::chrono::high_resolution_clock::now();
+    GraphGenerator generator(seed);
+    if (radius > 0.0) {
+        generator.streamGeometricGraph(vertices, radius, weighted, *sink);
+    } else {
+        generator.streamRandomGraph(vertices, edges, directed, *sink);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    
+    if (!toStdout) {
+        long long written = binarySink ? binarySink->getWrittenEdges() : textSink->getWrittenEdges();
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+        std::cout << "Wrote " << written << " edges (" << vertices << " vertices, "
+                  << (radius > 0.0 ? "geometric, " : "")
+                  << (directed ? "directed" : "undirected") << ", " << format
+                  << ") to " << outPath << " in " << ms << " ms\n";
+    }
+    return 0;
+}
+
 void printGraphInfo(const Graph& graph) {
     std::cout << "Graph: " << graph.getVertexCount() << " vertices, " 
               << graph.getEdgeCount() << " edges, " 
@@ -191,4 +314,68 @@ void runTests() {
     Graph complete = generator.generateCompleteGraph(4, false);
     printGraphInfo(complete);
     printEulerResult(complete);
+    
+    std::cout << "\nTest 4: Streamed random graph (8 vertices, 12 edges)\n";
+    GraphBuilderSink builder;
+    generator.streamRandomGraph(8, 12, false, builder);
+    Graph streamed = builder.takeGraph();
+    printGraphInfo(streamed);
+    std::cout << "Edge count matches request: " << (streamed.getEdgeCount() == 12 ? "YES" : "NO") << "\n";
+    
+    std::cout << "\nTest 5: Planted instances (ground truth)\n";
+    PlantedInstance clique = generator.generatePlantedClique(30, 0.3, 7);
+    printGraphInfo(clique.graph);
+    std::cout << "Planted clique of size " << clique.cliqueLowerBound << " valid: "
+              << (GraphGenerator::isClique(clique.graph, clique.witness) ? "YES" : "NO") << "\n";
+    PlantedInstance hamilton = generator.generateNearThresholdHamilton(30, false);
+    printGraphInfo(hamilton.graph);
+    std::cout << "Planted Hamilton cycle valid: "
+              << (GraphGenerator::isHamiltonCycle(hamilton.graph, hamilton.witness) ? "YES" : "NO") << "\n";
+    
+    std::cout << "\nTest 6: Random geometric graph (200 vertices, radius 0.1)\n";
+    std::vector<WeightedEdge> weightedEdges;
+    Graph geometric = generator.generateGeometricGraph(200, 0.1, &weightedEdges);
+    printGraphInfo(geometric);
+    bool weightsValid = static_cast<int>(weightedEdges.size()) == geometric.getEdgeCount();
+    for (const auto& edge : weightedEdges) {
+        weightsValid = weightsValid && edge.weight <= 0.1 && geometric.hasEdge(edge.u, edge.v);
+    }
+    std::cout << "Edge weights within radius: " << (weightsValid ? "YES" : "NO") << "\n";
+    
+    std::cout << "\nTest 7: Edge hash\n";
+    Graph forward(4, false), backward(4, false);
+    forward.addEdge(0, 1); forward.addEdge(1, 2); forward.addEdge(2, 3);
+    backward.addEdge(3, 2); backward.addEdge(2, 1); backward.addEdge(1, 0);
+    std::cout << "Independent of edge order: " << (forward.getHash() == backward.getHash() ? "YES" : "NO") << "\n";
+    forward.addEdge(3, 0);
+    forward.removeEdge(0, 3);
+    std::cout << "Restored after add and remove: " << (forward.getHash() == backward.getHash() ? "YES" : "NO") << "\n";
+    forward.clear();
+    std::cout << "Cleared graph hashes like an empty one: "
+              << (forward.getHash() == Graph(4, false).getHash() ? "YES" : "NO") << "\n";
+    
+    std::cout << "\nTest 8: Directed cycles not strongly connected\n";
+    std::vector<int> componentOf;
+    Graph joined(6, true);
+    joined.addEdge(0, 1); joined.addEdge(1, 2); joined.addEdge(2, 0);
+    joined.addEdge(3, 4); joined.addEdge(4, 5); joined.addEdge(5, 3);
+    joined.addEdge(2, 3);
+    std::cout << "Two cycles joined by one arc, components: "
+              << joined.getStronglyConnectedComponents(componentOf) << " (expected 2)\n";
+    printEulerResult(joined);
+    // Every vertex balanced, yet two components: only the connectivity
+    // check can reject it
+    Graph balanced(6, true);
+    balanced.addEdge(0, 1); balanced.addEdge(1, 2); balanced.addEdge(2, 0);
+    balanced.addEdge(3, 4); balanced.addEdge(4, 5); balanced.addEdge(5, 3);
+    std::cout << "Two balanced cycles, components: "
+              << balanced.getStronglyConnectedComponents(componentOf) << " (expected 2)\n";
+    printEulerResult(balanced);
+    
+    std::cout << "\nTest 9: Long directed cycle (200000 vertices)\n";
+    Graph ring = generator.generateCycleGraph(200000, true);
+    printGraphInfo(ring);
+    std::cout << "Strongly connected components: "
+              << ring.getStronglyConnectedComponents(componentOf) << " (expected 1)\n";
+    printEulerResult(ring);
 }
\ No newline at end of file
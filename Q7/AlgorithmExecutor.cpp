@@ -0,0 +1,92 @@
+#include "AlgorithmExecutor.h"
+#include "ResultCache.h"
+#include "ThreadPool.h"
+#include <chrono>
+#include <exception>
+
+AlgorithmResult AlgorithmExecutor::run(AlgorithmType type, GraphAnalysisContext& analysis, ExecutionContext& context) {
+    ResultCache& cache = ResultCache::shared();
+    if (!cache.isEnabled()) {
+        return execute(type, analysis, context);
+    }
+    
+    auto start = std::chrono::high_resolution_clock::now();
+    auto finish = [&start](AlgorithmResult& result) {
+        // Report the time this request spent, not the original run's
+        auto end = std::chrono::high_resolution_clock::now();
+        result.executionTime = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        return result;
+    };
+    
+    const Graph& graph = analysis.getGraph();
+    AlgorithmResult result;
+    ResultCache::Key key = ResultCache::makeKey(graph, type);
+    if (cache.lookup(key, result)) {
+        return finish(result);
+    }
+    
+    // Same topology under other vertex numbers, if a canonical labeling is
+    // found in time. Refinement rounds on large graphs rarely finish within
+    // the budget, so those are not tried on every miss.
+    const CanonicalForm* canonical = nullptr;
+    ResultCache::Key canonicalKey{};
+    AlgorithmConfig config = AlgorithmFactory::getConfig();
+    int budgetMs = config.canonicalBudgetMs;
+    if (budgetMs > 0 && graph.getVertexCount() <= config.canonicalMaxVertices) {
+        const CanonicalForm& form = analysis.canonicalForm(context, std::chrono::milliseconds(budgetMs));
+        if (form.complete) {
+            canonical = &form;
+            canonicalKey = ResultCache::makeCanonicalKey(graph, form, type);
+            if (cache.lookup(canonicalKey, result)) {
+                ResultCache::relabel(result, form.vertexOf);
+                cache.insert(key, result);
+                return finish(result);
+            }
+        }
+    }
+    
+    cache.recordMiss();
+    result = execute(type, analysis, context);
+    cache.insert(key, result);
+    if (canonical) {
+        AlgorithmResult relabeled = result;
+        ResultCache::relabel(relabeled, canonical->labelOf);
+        cache.insert(canonicalKey, relabeled);
+    }
+    return result;
+}
+
+AlgorithmResult AlgorithmExecutor::execute(AlgorithmType type, GraphAnalysisContext& analysis, ExecutionContext& context) {
+    AlgorithmResult result;
+    // Strategies report their own failures; this catches the factory's
+    try {
+        auto algorithm = AlgorithmFactory::createAlgorithm(type);
+        result = algorithm->execute(analysis, context);
+    } catch (const std::exception& e) {
+        result.success = false;
+        result.error = e.what();
+    }
+    return result;
+}
+
+std::vector<AlgorithmResult> AlgorithmExecutor::runAll(const std::vector<AlgorithmType>& types,
+                                                       GraphAnalysisContext& analysis, ExecutionContext& context) {
+    std::vector<AlgorithmResult> results(types.size());
+    
+    TaskGroup group(ThreadPool::shared());
+    for (size_t i = 0; i < types.size(); i++) {
+        group.run([&results, &types, &analysis, &context, i]() {
+            // The cache lookup and canonical labeling run outside the
+            // strategy's own error handling
+            try {
+                results[i] = run(types[i], analysis, context);
+            } catch (const std::exception& e) {
+                results[i] = AlgorithmResult();
+                results[i].error = e.what();
+            }
+        });
+    }
+    group.wait();
+    
+    return results;
+}
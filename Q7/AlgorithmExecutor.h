@@ -0,0 +1,31 @@
+#ifndef ALGORITHM_EXECUTOR_H
+#define ALGORITHM_EXECUTOR_H
+
+#include "AlgorithmFactory.h"
+#include "GraphAnalysisContext.h"
+#include <vector>
+
+// Runs several algorithms on one graph at the same time and joins them. Each
+// algorithm is a task on the shared thread pool with its own strategy object;
+// all of them share the graph analysis (so derived data is still built once)
+// and the request's execution context (so one deadline, budget or
+// cancellation stops them all). Every result keeps its own executionTime, and
+// the batch takes about as long as its slowest algorithm.
+//
+// Both entry points answer from the shared ResultCache when the same graph,
+// or one isomorphic to it, has been solved before, and store exact results
+// they compute.
+class AlgorithmExecutor {
+public:
+    static AlgorithmResult run(AlgorithmType type, GraphAnalysisContext& analysis, ExecutionContext& context);
+    
+    // Results in the order of types
+    static std::vector<AlgorithmResult> runAll(const std::vector<AlgorithmType>& types,
+                                               GraphAnalysisContext& analysis, ExecutionContext& context);
+
+private:
+    // Runs the strategy itself, bypassing the cache
+    static AlgorithmResult execute(AlgorithmType type, GraphAnalysisContext& analysis, ExecutionContext& context);
+};
+
+#endif
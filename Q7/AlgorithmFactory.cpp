@@ -3,19 +3,97 @@
 #include "Max_clique_algorithm.h"
 #include "Mst_algorithm.h"
 #include "hamilton_algorithm.h"
+#include "scc_algorithm.h"
+#include "triangle_algorithm.h"
+#include "kcore_algorithm.h"
+#include "components_algorithm.h"
+#include "diameter_algorithm.h"
+#include "pagerank_algorithm.h"
 #include <stdexcept>
 #include <algorithm>
+#include <cstdlib>
+#include <mutex>
+
+namespace {
+std::mutex configMutex;
+AlgorithmConfig currentConfig;
+
+int readPositiveEnv(const char* name, int fallback) {
+    const char* value = std::getenv(name);
+    if (!value) return fallback;
+    int parsed = std::atoi(value);
+    return parsed > 0 ? parsed : fallback;
+}
+
+long long readPositiveEnv(const char* name, long long fallback) {
+    const char* value = std::getenv(name);
+    if (!value) return fallback;
+    long long parsed = std::atoll(value);
+    return parsed > 0 ? parsed : fallback;
+}
+
+int readNonNegativeEnv(const char* name, int fallback) {
+    const char* value = std::getenv(name);
+    if (!value || !*value) return fallback;
+    int parsed = std::atoi(value);
+    return parsed >= 0 ? parsed : fallback;
+}
+}
+
+AlgorithmConfig AlgorithmConfig::fromEnvironment() {
+    AlgorithmConfig config;
+    config.cliqueMaxVertices = readPositiveEnv("CLIQUE_MAX_VERTICES", config.cliqueMaxVertices);
+    config.hamiltonDpMaxVertices = readPositiveEnv("HAMILTON_DP_MAX_VERTICES", config.hamiltonDpMaxVertices);
+    config.hamiltonSearchMaxVertices = readPositiveEnv("HAMILTON_SEARCH_MAX_VERTICES", config.hamiltonSearchMaxVertices);
+    config.requestTimeoutMs = readPositiveEnv("REQUEST_TIMEOUT_MS", config.requestTimeoutMs);
+    config.requestStepBudget = readPositiveEnv("REQUEST_STEP_BUDGET", config.requestStepBudget);
+    config.resultCacheMb = readNonNegativeEnv("RESULT_CACHE_MB", config.resultCacheMb);
+    config.canonicalBudgetMs = readNonNegativeEnv("CANONICAL_BUDGET_MS", config.canonicalBudgetMs);
+    config.canonicalMaxVertices = readPositiveEnv("CANONICAL_MAX_VERTICES", config.canonicalMaxVertices);
+    return config;
+}
+
+void AlgorithmConfig::applyRequestLimits(ExecutionContext& context) const {
+    context.setTimeout(std::chrono::milliseconds(requestTimeoutMs));
+    if (requestStepBudget > 0) {
+        context.setStepBudget(requestStepBudget);
+    }
+}
+
+void AlgorithmFactory::setConfig(const AlgorithmConfig& config) {
+    std::lock_guard<std::mutex> lock(configMutex);
+    currentConfig = config;
+}
+
+AlgorithmConfig AlgorithmFactory::getConfig() {
+    std::lock_guard<std::mutex> lock(configMutex);
+    return currentConfig;
+}
 
 std::unique_ptr<BaseAlgorithm> AlgorithmFactory::createAlgorithm(AlgorithmType type) {
     switch (type) {
         case AlgorithmType::EULER_CIRCUIT:
             return std::make_unique<EulerAlgorithm>();
         case AlgorithmType::MAX_CLIQUE:
-            return std::make_unique<MaxCliqueAlgorithm>();
+            return std::make_unique<MaxCliqueAlgorithm>(getConfig().cliqueMaxVertices);
         case AlgorithmType::MST_WEIGHT:
             return std::make_unique<MSTAlgorithm>();
-        case AlgorithmType::HAMILTON_CIRCUIT:
-            return std::make_unique<HamiltonAlgorithm>();
+        case AlgorithmType::HAMILTON_CIRCUIT: {
+            AlgorithmConfig config = getConfig();
+            return std::make_unique<HamiltonAlgorithm>(config.hamiltonDpMaxVertices, config.hamiltonSearchMaxVertices);
+        }
+        case AlgorithmType::STRONG_COMPONENTS:
+            return std::make_unique<SccAlgorithm>();
+        case AlgorithmType::TRIANGLES:
+            return std::make_unique<TriangleAlgorithm>();
+        case AlgorithmType::K_CORE:
+            return std::make_unique<KCoreAlgorithm>();
+        case AlgorithmType::CONNECTED_COMPONENTS:
+            return std::make_unique<ConnectedComponentsAlgorithm>();
+        case AlgorithmType::DIAMETER:
+            return std::make_unique<DiameterAlgorithm>();
+        case AlgorithmType::PAGERANK:
+            return std::make_unique<PageRankAlgorithm>();
         default:
             throw std::invalid_argument("Unknown algorithm type");
     }
@@ -26,7 +104,7 @@ std::unique_ptr<BaseAlgorithm> AlgorithmFactory::createAlgorithm(const std::stri
 }
 
 std::vector<std::string> AlgorithmFactory::getAllAlgorithmNames() {
-    return {"euler", "clique", "mst", "hamilton"};
+    return {"euler", "clique", "mst", "hamilton", "scc", "triangles", "kcore", "components", "diameter", "pagerank"};
 }
 
 std::vector<AlgorithmType> AlgorithmFactory::getAllAlgorithmTypes() {
@@ -34,7 +112,13 @@ std::vector<AlgorithmType> AlgorithmFactory::getAllAlgorithmTypes() {
         AlgorithmType::EULER_CIRCUIT,
         AlgorithmType::MAX_CLIQUE,
         AlgorithmType::MST_WEIGHT,
-        AlgorithmType::HAMILTON_CIRCUIT
+        AlgorithmType::HAMILTON_CIRCUIT,
+        AlgorithmType::STRONG_COMPONENTS,
+        AlgorithmType::TRIANGLES,
+        AlgorithmType::K_CORE,
+        AlgorithmType::CONNECTED_COMPONENTS,
+        AlgorithmType::DIAMETER,
+        AlgorithmType::PAGERANK
     };
 }
 
@@ -44,6 +128,12 @@ std::string AlgorithmFactory::typeToString(AlgorithmType type) {
         case AlgorithmType::MAX_CLIQUE: return "clique";
         case AlgorithmType::MST_WEIGHT: return "mst";
         case AlgorithmType::HAMILTON_CIRCUIT: return "hamilton";
+        case AlgorithmType::STRONG_COMPONENTS: return "scc";
+        case AlgorithmType::TRIANGLES: return "triangles";
+        case AlgorithmType::K_CORE: return "kcore";
+        case AlgorithmType::CONNECTED_COMPONENTS: return "components";
+        case AlgorithmType::DIAMETER: return "diameter";
+        case AlgorithmType::PAGERANK: return "pagerank";
         default: throw std::invalid_argument("Unknown algorithm type");
     }
 }
@@ -56,6 +146,12 @@ AlgorithmType AlgorithmFactory::stringToType(const std::string& name) {
     if (lowerName == "clique") return AlgorithmType::MAX_CLIQUE;
     if (lowerName == "mst") return AlgorithmType::MST_WEIGHT;
     if (lowerName == "hamilton") return AlgorithmType::HAMILTON_CIRCUIT;
+    if (lowerName == "scc") return AlgorithmType::STRONG_COMPONENTS;
+    if (lowerName == "triangles") return AlgorithmType::TRIANGLES;
+    if (lowerName == "kcore") return AlgorithmType::K_CORE;
+    if (lowerName == "components") return AlgorithmType::CONNECTED_COMPONENTS;
+    if (lowerName == "diameter") return AlgorithmType::DIAMETER;
+    if (lowerName == "pagerank") return AlgorithmType::PAGERANK;
     
     throw std::invalid_argument("Unknown algorithm: " + name);
 }
@@ -2,6 +2,7 @@
 #define ALGORITHM_FACTORY_H
 
 #include "BaseAlgorithm.h"
+#include "ExecutionContext.h"
 #include <string>
 #include <vector>
 #include <memory>
@@ -10,11 +11,46 @@ enum class AlgorithmType {
     EULER_CIRCUIT,
     MAX_CLIQUE,
     MST_WEIGHT,
-    HAMILTON_CIRCUIT
+    HAMILTON_CIRCUIT,
+    STRONG_COMPONENTS,
+    TRIANGLES,
+    K_CORE,
+    CONNECTED_COMPONENTS,
+    DIAMETER,
+    PAGERANK
+};
+
+// Limits shared by every algorithm the factory creates. Servers install it
+// once at startup, before any worker thread runs.
+struct AlgorithmConfig {
+    int cliqueMaxVertices;      // Vertex limit of the clique search after k-core pruning
+    int hamiltonDpMaxVertices;  // Largest graph solved by the Held-Karp table (capped at 25)
+    int hamiltonSearchMaxVertices; // Largest undirected graph given to the pruned search
+    int requestTimeoutMs;       // Deadline for all algorithms of one server request
+    long long requestStepBudget; // Steps allowed per server request, 0 for no budget
+    int resultCacheMb;          // Memory budget of the shared result cache, 0 to disable it
+    int canonicalBudgetMs;      // Time to find a canonical labeling on a cache miss, 0 to skip it
+    int canonicalMaxVertices;   // Larger graphs skip the canonical labeling
+    
+    AlgorithmConfig()
+        : cliqueMaxVertices(1000), hamiltonDpMaxVertices(25), hamiltonSearchMaxVertices(500),
+          requestTimeoutMs(5000), requestStepBudget(0), resultCacheMb(64), canonicalBudgetMs(20),
+          canonicalMaxVertices(5000) {}
+    
+    // Per-request limits for a server request's execution context
+    void applyRequestLimits(ExecutionContext& context) const;
+    
+    // Defaults overridden by CLIQUE_MAX_VERTICES, HAMILTON_DP_MAX_VERTICES,
+    // HAMILTON_SEARCH_MAX_VERTICES, REQUEST_TIMEOUT_MS, REQUEST_STEP_BUDGET,
+    // RESULT_CACHE_MB, CANONICAL_BUDGET_MS and CANONICAL_MAX_VERTICES when set
+    static AlgorithmConfig fromEnvironment();
 };
 
 class AlgorithmFactory {
 public:
+    static void setConfig(const AlgorithmConfig& config);
+    static AlgorithmConfig getConfig();
+    
     static std::unique_ptr<BaseAlgorithm> createAlgorithm(AlgorithmType type);
     static std::unique_ptr<BaseAlgorithm> createAlgorithm(const std::string& name);
     static std::vector<std::string> getAllAlgorithmNames();
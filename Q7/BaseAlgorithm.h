@@ -2,22 +2,94 @@
 #define BASE_ALGORITHM_H
 
 #include "Graph.h"
+#include "ExecutionContext.h"
+#include "GraphAnalysisContext.h"
 #include <string>
 #include <memory>
+#include <utility>
+#include <vector>
+
+// Shape of a successful answer. Algorithms fill in typed fields only; the
+// response writer (ResultWriter.h) turns them into text or binary once.
+enum class ResultKind {
+    NONE,
+    EULER_CIRCUIT,      // found, vertices = closed walk over every edge
+    HAMILTON_CIRCUIT,   // found, vertices = closed circuit, or the longest
+                        // path found when not exact
+    CLIQUE,             // vertices = members, sorted
+    SPANNING_TREE,      // weight, edges; trees > 1 for a spanning forest
+    STRONG_COMPONENTS,  // trees = component count, vertices[v] = component
+                        // of vertex v, numbered in order of smallest member
+    TRIANGLES,          // weight = triangle count, values[v] = local
+                        // clustering coefficient of v
+    CORES,              // weight = degeneracy, vertices[v] = core number of v
+    COMPONENTS,         // Connected (for directed graphs, weak) components,
+                        // laid out as STRONG_COMPONENTS
+    DIAMETER,           // weight = diameter in hops, vertices = the two ends
+                        // of a longest shortest path, values[v] = eccentricity
+                        // of v (a lower bound on large graphs)
+    PAGERANK            // weight = iterations run, values[v] = score of v
+};
 
 struct AlgorithmResult {
     bool success;
-    std::string result;
-    std::string error;
+    bool exact;             // False when result is a best-so-far answer or a bound
+    bool interrupted;       // Stopped by the context's deadline, budget or cancellation
+    
+    ResultKind kind;
+    bool found;                                 // A circuit exists
+    std::vector<int> vertices;
+    long long weight;       // SPANNING_TREE: total edge weight; TRIANGLES:
+                            // number of triangles; CORES: degeneracy;
+                            // DIAMETER: longest shortest path in hops;
+                            // PAGERANK: power iterations run
+    std::vector<std::pair<int, int>> edges;
+    int upperBound;         // Not exact: best value still possible (clique size, path length)
+    int trees;              // Components with edges a spanning forest covers,
+                            // or all components for STRONG_COMPONENTS and COMPONENTS
+    std::vector<double> values; // Per-vertex scores, indexed by vertex
+    
+    std::string error;      // Failure reason, or why a partial result is not exact
     long executionTime;
     
-    AlgorithmResult() : success(false), executionTime(0) {}
+    AlgorithmResult()
+        : success(false), exact(true), interrupted(false), kind(ResultKind::NONE), found(false),
+          weight(0), upperBound(0), trees(0), executionTime(0) {}
+    
+    // Stopped with nothing useful to report
+    void markInterrupted(const ExecutionContext& context) {
+        success = false;
+        interrupted = true;
+        error = context.describeStop();
+    }
+    
+    // Stopped early, but result holds the best answer found so far
+    void markPartial(const std::string& reason) {
+        success = true;
+        exact = false;
+        error = reason;
+    }
 };
 
 class BaseAlgorithm {
 public:
     virtual ~BaseAlgorithm() = default;
-    virtual AlgorithmResult execute(const Graph& graph) = 0;
+    
+    // Runs until done or until the context says stop. Derived data of the
+    // graph comes from analysis, which may be shared with other algorithms.
+    virtual AlgorithmResult execute(GraphAnalysisContext& analysis, ExecutionContext& context) = 0;
+    
+    AlgorithmResult execute(const Graph& graph, ExecutionContext& context) {
+        GraphAnalysisContext analysis(graph);
+        return execute(analysis, context);
+    }
+    
+    // Runs without limits
+    AlgorithmResult execute(const Graph& graph) {
+        ExecutionContext unlimited;
+        return execute(graph, unlimited);
+    }
+    
     virtual std::string getName() const = 0;
     virtual bool supportsDirected() const = 0;
     virtual bool supportsUndirected() const = 0;
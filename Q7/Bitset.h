@@ -0,0 +1,101 @@
+#ifndef BITSET_H
+#define BITSET_H
+
+#include <cstdint>
+#include <vector>
+
+// Fixed-size vertex set packed into 64-bit words. Used for adjacency rows and
+// candidate sets in the exponential searches, where set intersection and
+// population count dominate the running time.
+class Bitset {
+private:
+    std::vector<uint64_t> words;
+    int bitCount;
+
+public:
+    Bitset() : bitCount(0) {}
+    explicit Bitset(int bits) : words((bits + 63) / 64, 0), bitCount(bits) {}
+
+    int size() const { return bitCount; }
+    int wordCount() const { return static_cast<int>(words.size()); }
+    uint64_t word(int w) const { return words[w]; }
+    uint64_t* data() { return words.data(); }
+    const uint64_t* data() const { return words.data(); }
+
+    void set(int i) { words[i >> 6] |= 1ULL << (i & 63); }
+    void reset(int i) { words[i >> 6] &= ~(1ULL << (i & 63)); }
+    bool test(int i) const { return (words[i >> 6] >> (i & 63)) & 1ULL; }
+
+    void clear() {
+        for (auto& w : words) w = 0;
+    }
+
+    bool any() const {
+        for (uint64_t w : words) {
+            if (w) return true;
+        }
+        return false;
+    }
+
+    int count() const {
+        int total = 0;
+        for (uint64_t w : words) total += __builtin_popcountll(w);
+        return total;
+    }
+
+    // Lowest set bit at or after from, or -1
+    int next(int from) const {
+        if (from >= bitCount) return -1;
+        int w = from >> 6;
+        uint64_t bits = words[w] & (~0ULL << (from & 63));
+        while (true) {
+            if (bits) return (w << 6) + __builtin_ctzll(bits);
+            if (++w >= wordCount()) return -1;
+            bits = words[w];
+        }
+    }
+
+    int first() const { return next(0); }
+
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (int w = 0; w < wordCount(); w++) {
+            uint64_t bits = words[w];
+            while (bits) {
+                fn((w << 6) + __builtin_ctzll(bits));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    Bitset& operator&=(const Bitset& other) {
+        for (int w = 0; w < wordCount(); w++) words[w] &= other.words[w];
+        return *this;
+    }
+
+    Bitset& operator|=(const Bitset& other) {
+        for (int w = 0; w < wordCount(); w++) words[w] |= other.words[w];
+        return *this;
+    }
+
+    // this &= ~other
+    Bitset& subtract(const Bitset& other) {
+        for (int w = 0; w < wordCount(); w++) words[w] &= ~other.words[w];
+        return *this;
+    }
+
+    // out = a & b, reusing out's storage
+    static void intersect(const Bitset& a, const Bitset& b, Bitset& out) {
+        out.bitCount = a.bitCount;
+        out.words.resize(a.words.size());
+        for (size_t w = 0; w < a.words.size(); w++) out.words[w] = a.words[w] & b.words[w];
+    }
+
+    int intersectCount(const Bitset& other) const {
+        int total = 0;
+        for (int w = 0; w < wordCount(); w++) total += __builtin_popcountll(words[w] & other.words[w]);
+        return total;
+    }
+};
+
+#endif
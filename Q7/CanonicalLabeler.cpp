@@ -0,0 +1,202 @@
+#include "CanonicalLabeler.h"
+#include <algorithm>
+#include <numeric>
+
+CanonicalLabeler::CanonicalLabeler(GraphAnalysisContext& analysis, ExecutionContext& context)
+    : n(analysis.getGraph().getVertexCount()), directed(analysis.getGraph().isDirected()),
+      out(analysis.adjacency()), in(analysis.inAdjacency()), context(context),
+      leaves(0), aborted(false), uncharged(0) {
+    const std::vector<int>& degree = analysis.degrees();
+    hasLoop.assign(n, 0);
+    for (int v = 0; v < n; v++) {
+        // The adjacency array drops self-loops but the degree still counts them
+        hasLoop[v] = degree[v] != out.degree(v);
+    }
+}
+
+CanonicalForm CanonicalLabeler::compute(GraphAnalysisContext& analysis, ExecutionContext& context) {
+    CanonicalLabeler labeler(analysis, context);
+    int n = labeler.n;
+
+    int loops = static_cast<int>(std::count(labeler.hasLoop.begin(), labeler.hasLoop.end(), 1));
+    std::vector<int> colors(n, 0);
+    int cells = 1;
+    if (loops > 0 && loops < n) {
+        for (int v = 0; v < n; v++) colors[v] = labeler.hasLoop[v];
+        cells = 2;
+    }
+    try {
+        if (context.check()) throw Stopped();
+        labeler.search(colors, cells);
+    } catch (const Stopped&) {
+        labeler.aborted = true;
+    }
+
+    CanonicalForm form;
+    if (labeler.aborted || labeler.bestLabels.empty()) {
+        return form;
+    }
+
+    form.complete = true;
+    form.labelOf = std::move(labeler.bestLabels);
+    form.vertexOf.resize(n);
+    for (int v = 0; v < n; v++) {
+        form.vertexOf[form.labelOf[v]] = v;
+    }
+
+    auto mix = [](uint64_t h, uint64_t value) {
+        h = (h ^ value) * 0x9e3779b97f4a7c15ULL;
+        return h ^ (h >> 29);
+    };
+    uint64_t h = mix(mix(0, static_cast<uint64_t>(n)), labeler.directed ? 1 : 0);
+    for (const auto& edge : labeler.bestCertificate) {
+        h = mix(h, (static_cast<uint64_t>(edge.first) << 32) | static_cast<uint32_t>(edge.second));
+    }
+    form.hash = h;
+    return form;
+}
+
+void CanonicalLabeler::spend(long long steps) {
+    uncharged += steps;
+    if (uncharged < CHARGE_INTERVAL) return;
+    bool stopped = context.charge(uncharged);
+    uncharged = 0;
+    if (stopped) throw Stopped();
+}
+
+int CanonicalLabeler::refine(std::vector<int>& colors, int cells) {
+    std::vector<int> order(n), next(n);
+    std::vector<size_t> start(n + 1);
+    std::vector<int> signature;
+
+    while (cells < n) {
+        // Signature of v: its color, out-degree, sorted out-neighbor colors,
+        // then sorted in-neighbor colors when directed
+        signature.clear();
+        for (int v = 0; v < n; v++) {
+            start[v] = signature.size();
+            signature.push_back(colors[v]);
+            signature.push_back(out.degree(v));
+            size_t first = signature.size();
+            for (const int* u = out.begin(v); u != out.end(v); ++u) {
+                signature.push_back(colors[*u]);
+            }
+            std::sort(signature.begin() + first, signature.end());
+            if (directed) {
+                first = signature.size();
+                for (const int* u = in.begin(v); u != in.end(v); ++u) {
+                    signature.push_back(colors[*u]);
+                }
+                std::sort(signature.begin() + first, signature.end());
+            }
+            spend(static_cast<long long>(signature.size() - start[v]));
+        }
+        start[n] = signature.size();
+
+        auto less = [&](int a, int b) {
+            spend(1);
+            return std::lexicographical_compare(signature.begin() + start[a], signature.begin() + start[a + 1],
+                                                signature.begin() + start[b], signature.begin() + start[b + 1]);
+        };
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), less);
+
+        int rank = 0;
+        for (int i = 0; i < n; i++) {
+            if (i > 0 && less(order[i - 1], order[i])) rank++;
+            next[order[i]] = rank;
+        }
+        // The old color leads each signature, so an equal count means the
+        // same partition and the same ranks
+        if (rank + 1 == cells) {
+            break;
+        }
+        colors.swap(next);
+        cells = rank + 1;
+    }
+    return cells;
+}
+
+void CanonicalLabeler::search(std::vector<int>& colors, int cells) {
+    cells = refine(colors, cells);
+
+    // Branch on the first cell, in color order, with several vertices that
+    // have edges
+    std::vector<int> size(cells, 0);
+    std::vector<int> member(cells);
+    for (int v = 0; v < n; v++) {
+        size[colors[v]]++;
+        member[colors[v]] = v;
+    }
+    int target = -1;
+    for (int c = 0; c < cells; c++) {
+        if (size[c] > 1 && !isIsolated(member[c])) {
+            target = c;
+            break;
+        }
+    }
+    if (target < 0) {
+        visitLeaf(colors);
+        return;
+    }
+
+    std::vector<int> branch(n);
+    for (int v = 0; v < n; v++) {
+        if (colors[v] != target) continue;
+        if (leaves >= MAX_LEAVES) {
+            aborted = true;
+            return;
+        }
+        // v keeps the cell's color; the rest of the cell moves just after it
+        for (int u = 0; u < n; u++) {
+            int c = colors[u];
+            branch[u] = (c > target || (c == target && u != v)) ? c + 1 : c;
+        }
+        search(branch, cells + 1);
+        if (aborted) return;
+    }
+}
+
+void CanonicalLabeler::visitLeaf(const std::vector<int>& colors) {
+    leaves++;
+
+    // Colors are distinct except within cells of isolated vertices, which
+    // are numbered in vertex order
+    std::vector<int> order(n), labels(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&colors](int a, int b) { return colors[a] < colors[b]; });
+    for (int i = 0; i < n; i++) {
+        labels[order[i]] = i;
+    }
+
+    std::vector<std::pair<int, int>> certificate;
+    certificate.reserve(out.targets.size());
+    spend(n);
+    for (int v = 0; v < n; v++) {
+        spend(out.degree(v));
+        if (hasLoop[v]) {
+            certificate.push_back({labels[v], labels[v]});
+        }
+        for (const int* u = out.begin(v); u != out.end(v); ++u) {
+            if (directed) {
+                certificate.push_back({labels[v], labels[*u]});
+            } else if (v < *u) {
+                certificate.push_back({std::min(labels[v], labels[*u]), std::max(labels[v], labels[*u])});
+            }
+        }
+    }
+    std::sort(certificate.begin(), certificate.end(),
+              [this](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+                  spend(1);
+                  return a < b;
+              });
+
+    if (bestLabels.empty() || certificate < bestCertificate) {
+        bestCertificate.swap(certificate);
+        bestLabels.swap(labels);
+    }
+}
+
+bool CanonicalLabeler::isIsolated(int v) const {
+    return out.degree(v) == 0 && in.degree(v) == 0 && !hasLoop[v];
+}
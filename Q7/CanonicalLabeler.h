@@ -0,0 +1,65 @@
+#ifndef CANONICAL_LABELER_H
+#define CANONICAL_LABELER_H
+
+#include "GraphAnalysisContext.h"
+#include "ExecutionContext.h"
+#include <utility>
+#include <vector>
+
+// Canonical labeling by individualization-refinement, the scheme nauty
+// uses, without its automorphism pruning.
+//
+// Color refinement starts from self-loops and repeatedly splits vertices by
+// their color and the multiset of their neighbors' colors (out- and
+// in-neighbors separately when directed) until the partition is stable.
+// New colors are ranks of sorted signatures, so the partition depends only
+// on the graph's structure and not on its numbering. If some cell still
+// holds several vertices, each of them is individualized in turn and refined
+// again; every discrete partition reached is a candidate labeling, and the
+// one whose relabeled, sorted edge list is lexicographically smallest wins.
+// Cells of isolated vertices are never branched on since any order of them
+// gives the same edge list.
+//
+// Very symmetric graphs have large search trees, so the search gives up
+// after MAX_LEAVES candidates or when the context stops it. Work is charged
+// every CHARGE_INTERVAL steps (signature entries, comparisons of the sorts),
+// so a stop takes effect within a round of refinement, not after it.
+class CanonicalLabeler {
+public:
+    static constexpr int MAX_LEAVES = 256;
+    static constexpr long long CHARGE_INTERVAL = 4096;
+
+    static CanonicalForm compute(GraphAnalysisContext& analysis, ExecutionContext& context);
+
+private:
+    int n;
+    bool directed;
+    const AdjacencyArray& out;
+    const AdjacencyArray& in;   // The same as out when undirected
+    std::vector<char> hasLoop;
+    ExecutionContext& context;
+
+    int leaves;
+    bool aborted;
+    long long uncharged;
+    std::vector<std::pair<int, int>> bestCertificate;
+    std::vector<int> bestLabels;
+
+    CanonicalLabeler(GraphAnalysisContext& analysis, ExecutionContext& context);
+
+    // Thrown out of the search, from within a sort if need be, once the
+    // context has stopped
+    struct Stopped {};
+
+    // Adds steps of work, charging the context every CHARGE_INTERVAL; throws
+    // Stopped when it says stop
+    void spend(long long steps);
+    // Refines colors (ranks 0 .. cells - 1) to a stable partition and returns
+    // its cell count
+    int refine(std::vector<int>& colors, int cells);
+    void search(std::vector<int>& colors, int cells);
+    void visitLeaf(const std::vector<int>& colors);
+    bool isIsolated(int v) const;
+};
+
+#endif
@@ -1,32 +1,54 @@
 #include "EulerAlgorithm.h"
+#include "euler_tour.h"
+#include "ThreadPool.h"
+#include <algorithm>
 #include <chrono>
-#include <sstream>
+#include <vector>
 
-AlgorithmResult EulerAlgorithm::execute(const Graph& graph) {
+AlgorithmResult EulerAlgorithm::execute(GraphAnalysisContext& analysis, ExecutionContext& context) {
+    const Graph& graph = analysis.getGraph();
     auto start = std::chrono::high_resolution_clock::now();
     AlgorithmResult result;
     
     try {
-        bool hasEuler = graph.hasEulerCircuit();
-        
-        std::ostringstream output;
-        output << (hasEuler ? "YES" : "NO");
+        // Linear time: only a request that is already out of time is refused
+        if (context.check()) {
+            result.markInterrupted(context);
+            return result;
+        }
         
-        if (hasEuler) {
-            Graph tempGraph = graph;
-            std::vector<int> circuit = tempGraph.findEulerCircuit();
-            
-            if (!circuit.empty() && circuit.size() <= 15) {
-                output << " - Circuit: ";
-                for (size_t i = 0; i < circuit.size(); i++) {
-                    output << circuit[i];
-                    if (i < circuit.size() - 1) output << "->";
+        result.kind = ResultKind::EULER_CIRCUIT;
+        if (graph.isDirected()) {
+            // All edges in one strongly connected component and every
+            // in-degree equal to the out-degree (self-loops add one of each)
+            const AdjacencyArray& adj = analysis.adjacency();
+            std::vector<int> balance(graph.getVertexCount(), 0);
+            for (int v = 0; v < graph.getVertexCount(); v++) {
+                balance[v] += adj.degree(v);
+                for (const int* u = adj.begin(v); u != adj.end(v); ++u) {
+                    balance[*u]--;
                 }
             }
+            result.found = analysis.strongComponents().edgeComponents == 1 &&
+                           std::all_of(balance.begin(), balance.end(), [](int b) { return b == 0; });
+        } else {
+            // All edges in one component and every degree even
+            const std::vector<int>& degree = analysis.degrees();
+            result.found = analysis.components().edgeComponents == 1 &&
+                           std::all_of(degree.begin(), degree.end(), [](int d) { return d % 2 == 0; });
+        }
+        
+        if (result.found && useParallelTour(analysis)) {
+            if (!ParallelEulerTour::run(analysis.adjacency(), graph.isDirected(), result.vertices, context)) {
+                result.markInterrupted(context);
+                return result;
+            }
+        } else if (result.found) {
+            Graph tempGraph = graph;
+            result.vertices = tempGraph.findEulerCircuit();
         }
         
         result.success = true;
-        result.result = output.str();
         
     } catch (const std::exception& e) {
         result.success = false;
@@ -38,3 +60,17 @@ AlgorithmResult EulerAlgorithm::execute(const Graph& graph) {
     
     return result;
 }
+
+// The adjacency arrays drop self-loops, which the parallel tour would miss
+bool EulerAlgorithm::useParallelTour(GraphAnalysisContext& analysis) {
+    const Graph& graph = analysis.getGraph();
+    if (static_cast<size_t>(graph.getEdgeCount()) < PARALLEL_MIN_EDGES || ThreadPool::shared().size() < 2) {
+        return false;
+    }
+    const AdjacencyArray& adjacency = analysis.adjacency();
+    const std::vector<int>& degree = analysis.degrees();
+    for (int v = 0; v < graph.getVertexCount(); v++) {
+        if (adjacency.degree(v) != degree[v]) return false;
+    }
+    return true;
+}
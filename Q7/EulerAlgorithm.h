@@ -2,13 +2,25 @@
 #define EULER_ALGORITHM_H
 
 #include "BaseAlgorithm.h"
+#include <cstddef>
 
+// Euler circuit of a connected, balanced graph. The circuit comes from
+// Graph's Hierholzer, or for edge sets from PARALLEL_MIN_EDGES up, when the
+// shared pool has more than one thread and there are no self-loops, from
+// ParallelEulerTour (euler_tour.h). Either is a valid circuit; they need
+// not be the same one.
 class EulerAlgorithm : public BaseAlgorithm {
 public:
-    AlgorithmResult execute(const Graph& graph) override;
+    static constexpr size_t PARALLEL_MIN_EDGES = 262144;
+
+    using BaseAlgorithm::execute;
+    AlgorithmResult execute(GraphAnalysisContext& analysis, ExecutionContext& context) override;
     std::string getName() const override { return "Euler Circuit"; }
     bool supportsDirected() const override { return true; }
     bool supportsUndirected() const override { return true; }
+
+private:
+    static bool useParallelTour(GraphAnalysisContext& analysis);
 };
 
 #endif
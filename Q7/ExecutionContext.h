@@ -0,0 +1,118 @@
+#ifndef EXECUTION_CONTEXT_H
+#define EXECUTION_CONTEXT_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+
+// Shared flag a requester flips to abandon work it no longer needs (for
+// example when the client disconnects). Copies refer to the same flag.
+class CancellationToken {
+private:
+    std::shared_ptr<std::atomic<bool>> flag;
+
+public:
+    CancellationToken() : flag(std::make_shared<std::atomic<bool>>(false)) {}
+
+    void cancel() const { flag->store(true); }
+    bool isCancelled() const { return flag->load(std::memory_order_relaxed); }
+};
+
+// Limits for one algorithm run: a deadline, a step budget and a cancellation
+// token, all optional. Algorithms report work with charge() every few
+// thousand steps (one step is one search node, one DP subset or one edge)
+// and test isStopped() in between. Safe to share between the tasks of a
+// parallel search; once a limit is hit the verdict sticks.
+class ExecutionContext {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class StopReason { NONE, DEADLINE, STEP_BUDGET, CANCELLED };
+
+    ExecutionContext()
+        : started(Clock::now()), hasDeadline(false), timeout(0), stepBudget(-1),
+          stepsUsed(0), reason(static_cast<int>(StopReason::NONE)) {}
+
+    ExecutionContext(const ExecutionContext&) = delete;
+    ExecutionContext& operator=(const ExecutionContext&) = delete;
+
+    // Deadline relative to when the context was created
+    void setTimeout(std::chrono::milliseconds limit) {
+        timeout = limit;
+        deadline = started + limit;
+        hasDeadline = true;
+    }
+
+    void setStepBudget(long long steps) { stepBudget = steps; }
+    void setCancellationToken(const CancellationToken& cancellation) { token = cancellation; }
+
+    // For side work done on behalf of parent under limits of its own: also
+    // stop at parent's deadline if it is earlier, and on parent's token
+    void inheritLimits(const ExecutionContext& parent) {
+        if (parent.hasDeadline && (!hasDeadline || parent.deadline < deadline)) {
+            deadline = parent.deadline;
+            timeout = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - started);
+            hasDeadline = true;
+        }
+        token = parent.token;
+        if (parent.isStopped()) stop(parent.getStopReason());
+    }
+
+    // Adds steps of work and checks every limit; true once the caller must stop
+    bool charge(long long steps) {
+        long long used = stepsUsed.fetch_add(steps, std::memory_order_relaxed) + steps;
+        if (isStopped()) return true;
+
+        if (token.isCancelled()) {
+            stop(StopReason::CANCELLED);
+        } else if (stepBudget >= 0 && used > stepBudget) {
+            stop(StopReason::STEP_BUDGET);
+        } else if (hasDeadline && Clock::now() >= deadline) {
+            stop(StopReason::DEADLINE);
+        }
+        return isStopped();
+    }
+
+    // Checks the limits without adding work
+    bool check() { return charge(0); }
+
+    // Verdict of the last charge(); a single atomic load
+    bool isStopped() const {
+        return reason.load(std::memory_order_relaxed) != static_cast<int>(StopReason::NONE);
+    }
+
+    StopReason getStopReason() const { return static_cast<StopReason>(reason.load()); }
+    long long getStepsUsed() const { return stepsUsed.load(); }
+
+    std::string describeStop() const {
+        switch (getStopReason()) {
+            case StopReason::DEADLINE:
+                return "time limit of " + std::to_string(timeout.count()) + " ms exceeded";
+            case StopReason::STEP_BUDGET:
+                return "step budget of " + std::to_string(stepBudget) + " steps exhausted";
+            case StopReason::CANCELLED:
+                return "request cancelled";
+            default:
+                return "not stopped";
+        }
+    }
+
+private:
+    Clock::time_point started;
+    Clock::time_point deadline;
+    bool hasDeadline;
+    std::chrono::milliseconds timeout;
+    long long stepBudget;           // Negative means unlimited
+    CancellationToken token;
+
+    std::atomic<long long> stepsUsed;
+    std::atomic<int> reason;
+
+    void stop(StopReason why) {
+        int expected = static_cast<int>(StopReason::NONE);
+        reason.compare_exchange_strong(expected, static_cast<int>(why));
+    }
+};
+
+#endif
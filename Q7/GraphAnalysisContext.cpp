@@ -0,0 +1,232 @@
+#include "GraphAnalysisContext.h"
+#include "CanonicalLabeler.h"
+#include "afforest_components.h"
+#include <algorithm>
+
+const std::vector<int>& GraphAnalysisContext::degrees() {
+    std::call_once(degreesBuilt, [this]() {
+        int n = graph.getVertexCount();
+        degreeList.resize(n);
+        for (int v = 0; v < n; v++) {
+            degreeList[v] = graph.getOutDegree(v);
+        }
+    });
+    return degreeList;
+}
+
+const AdjacencyArray& GraphAnalysisContext::adjacency() {
+    std::call_once(adjacencyBuilt, [this]() { buildAdjacency(); });
+    return csr;
+}
+
+const AdjacencyArray& GraphAnalysisContext::inAdjacency() {
+    if (!graph.isDirected()) {
+        return adjacency();
+    }
+    std::call_once(inAdjacencyBuilt, [this]() { buildInAdjacency(); });
+    return inCsr;
+}
+
+const ComponentInfo& GraphAnalysisContext::components() {
+    std::call_once(componentsBuilt, [this]() { buildComponents(); });
+    return componentInfo;
+}
+
+const ComponentInfo& GraphAnalysisContext::strongComponents() {
+    if (!graph.isDirected()) {
+        return components();
+    }
+    std::call_once(strongComponentsBuilt, [this]() { buildStrongComponents(); });
+    return strongComponentInfo;
+}
+
+const CoreDecomposition& GraphAnalysisContext::cores() {
+    std::call_once(coresBuilt, [this]() { buildCores(); });
+    return coreDecomposition;
+}
+
+const std::vector<Bitset>& GraphAnalysisContext::bitsetAdjacency() {
+    std::call_once(bitsetBuilt, [this]() {
+        const AdjacencyArray& adj = adjacency();
+        int n = graph.getVertexCount();
+        bitsetRows.assign(n, Bitset(n));
+        for (int v = 0; v < n; v++) {
+            for (const int* u = adj.begin(v); u != adj.end(v); ++u) {
+                bitsetRows[v].set(*u);
+            }
+        }
+    });
+    return bitsetRows;
+}
+
+const CanonicalForm& GraphAnalysisContext::canonicalForm(const ExecutionContext& request,
+                                                         std::chrono::milliseconds budget) {
+    std::call_once(canonicalBuilt, [this, &request, budget]() {
+        ExecutionContext context;
+        context.setTimeout(budget);
+        context.inheritLimits(request);
+        canonical = CanonicalLabeler::compute(*this, context);
+    });
+    return canonical;
+}
+
+void GraphAnalysisContext::buildAdjacency() {
+    int n = graph.getVertexCount();
+    csr.offsets.assign(n + 1, 0);
+    csr.targets.clear();
+    csr.targets.reserve(graph.isDirected() ? graph.getEdgeCount() : 2 * static_cast<size_t>(graph.getEdgeCount()));
+
+    for (int v = 0; v < n; v++) {
+        size_t first = csr.targets.size();
+        for (int u : graph.getNeighbors(v)) {
+            if (u != v) csr.targets.push_back(u);
+        }
+        // Graph rejects duplicate edges, so sorting is all that is left
+        std::sort(csr.targets.begin() + first, csr.targets.end());
+        csr.offsets[v + 1] = static_cast<int>(csr.targets.size());
+    }
+}
+
+// Counting sort of the out-lists by target; sources are visited in order,
+// so every in-list comes out sorted
+void GraphAnalysisContext::buildInAdjacency() {
+    const AdjacencyArray& out = adjacency();
+    int n = graph.getVertexCount();
+
+    inCsr.offsets.assign(n + 1, 0);
+    for (int target : out.targets) {
+        inCsr.offsets[target + 1]++;
+    }
+    for (int v = 0; v < n; v++) {
+        inCsr.offsets[v + 1] += inCsr.offsets[v];
+    }
+    std::vector<int> fill(inCsr.offsets.begin(), inCsr.offsets.end() - 1);
+    inCsr.targets.resize(out.targets.size());
+    for (int v = 0; v < n; v++) {
+        for (const int* u = out.begin(v); u != out.end(v); ++u) {
+            inCsr.targets[fill[*u]++] = v;
+        }
+    }
+}
+
+void GraphAnalysisContext::buildComponents() {
+    const AdjacencyArray& adj = adjacency();
+    const std::vector<int>& degree = degrees();
+    int n = graph.getVertexCount();
+
+    // Following out-edges only is enough for weak components of a directed graph
+    std::vector<int> rootOf;
+    AfforestComponents::run(adj, graph.isDirected(), rootOf);
+
+    // Every root is the smallest vertex of its component, so it is numbered
+    // before any other member
+    componentInfo.componentOf.assign(n, -1);
+    componentInfo.sizes.clear();
+    componentInfo.count = 0;
+    componentInfo.edgeComponents = 0;
+    std::vector<char> hasEdges;
+    for (int v = 0; v < n; v++) {
+        if (rootOf[v] == v) {
+            componentInfo.componentOf[v] = componentInfo.count++;
+            componentInfo.sizes.push_back(0);
+            hasEdges.push_back(0);
+        }
+        int id = componentInfo.componentOf[rootOf[v]];
+        componentInfo.componentOf[v] = id;
+        componentInfo.sizes[id]++;
+        if (degree[v] > 0 && !hasEdges[id]) {
+            hasEdges[id] = 1;
+            componentInfo.edgeComponents++;
+        }
+    }
+}
+
+void GraphAnalysisContext::buildStrongComponents() {
+    const AdjacencyArray& adj = adjacency();
+    const std::vector<int>& degree = degrees();
+    int n = graph.getVertexCount();
+
+    std::vector<int> tarjanId;
+    int count = graph.getStronglyConnectedComponents(tarjanId);
+
+    // Tarjan numbers components in reverse topological order; renumber them
+    // by smallest vertex like components()
+    std::vector<char> hasEdges(n, 0);
+    for (int v = 0; v < n; v++) {
+        if (degree[v] > 0) hasEdges[v] = 1;
+        for (const int* u = adj.begin(v); u != adj.end(v); ++u) {
+            hasEdges[*u] = 1;
+        }
+    }
+    std::vector<int> renumber(count, -1);
+    std::vector<char> counted(count, 0);
+    strongComponentInfo.componentOf.assign(n, -1);
+    strongComponentInfo.sizes.assign(count, 0);
+    strongComponentInfo.count = 0;
+    strongComponentInfo.edgeComponents = 0;
+    for (int v = 0; v < n; v++) {
+        int& id = renumber[tarjanId[v]];
+        if (id < 0) id = strongComponentInfo.count++;
+        strongComponentInfo.componentOf[v] = id;
+        strongComponentInfo.sizes[id]++;
+        if (hasEdges[v] && !counted[id]) {
+            counted[id] = 1;
+            strongComponentInfo.edgeComponents++;
+        }
+    }
+}
+
+// Batagelj-Zaversnik: vertices sit in an array sorted by remaining degree,
+// with the start of every degree's block kept in bin. Removing the vertex of
+// least degree and lowering a neighbor's degree are both O(1) swaps, so the
+// whole decomposition is O(V + E).
+void GraphAnalysisContext::buildCores() {
+    const AdjacencyArray& adj = adjacency();
+    int n = graph.getVertexCount();
+
+    std::vector<int> degree(n);
+    int maxDegree = 0;
+    for (int v = 0; v < n; v++) {
+        degree[v] = adj.degree(v);
+        maxDegree = std::max(maxDegree, degree[v]);
+    }
+
+    std::vector<int> bin(maxDegree + 1, 0);
+    for (int v = 0; v < n; v++) bin[degree[v]]++;
+    for (int d = 0, start = 0; d <= maxDegree; d++) {
+        int count = bin[d];
+        bin[d] = start;
+        start += count;
+    }
+    std::vector<int> position(n);
+    std::vector<int>& order = coreDecomposition.order;
+    order.assign(n, 0);
+    for (int v = 0; v < n; v++) {
+        position[v] = bin[degree[v]]++;
+        order[position[v]] = v;
+    }
+    for (int d = maxDegree; d > 0; d--) bin[d] = bin[d - 1];
+    bin[0] = 0;
+
+    coreDecomposition.degeneracy = 0;
+    for (int i = 0; i < n; i++) {
+        int v = order[i];
+        coreDecomposition.degeneracy = std::max(coreDecomposition.degeneracy, degree[v]);
+        for (const int* it = adj.begin(v); it != adj.end(v); ++it) {
+            int u = *it;
+            if (degree[u] > degree[v]) {
+                // Swap u with the first vertex of its degree block, then
+                // shrink the block by one so u falls into the next lower one
+                int first = bin[degree[u]];
+                int w = order[first];
+                if (u != w) {
+                    std::swap(order[position[u]], order[first]);
+                    std::swap(position[u], position[w]);
+                }
+                bin[degree[u]]++;
+                degree[u]--;
+            }
+        }
+    }
+    coreDecomposition.coreOf = std::move(degree);
+}
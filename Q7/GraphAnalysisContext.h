@@ -0,0 +1,118 @@
+#ifndef GRAPH_ANALYSIS_CONTEXT_H
+#define GRAPH_ANALYSIS_CONTEXT_H
+
+#include "Graph.h"
+#include "Bitset.h"
+#include "ExecutionContext.h"
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Simple-graph adjacency in CSR form: neighbors of v are
+// targets[offsets[v] .. offsets[v + 1]), sorted, without self-loops.
+// Out-neighbors for directed graphs.
+struct AdjacencyArray {
+    std::vector<int> offsets;
+    std::vector<int> targets;
+
+    int degree(int v) const { return offsets[v + 1] - offsets[v]; }
+    const int* begin(int v) const { return targets.data() + offsets[v]; }
+    const int* end(int v) const { return targets.data() + offsets[v + 1]; }
+};
+
+// Weakly (or strongly) connected components, numbered in order of their
+// smallest vertex, with sizes[c] the vertex count of component c. Isolated
+// vertices are components of their own; edgeComponents counts only those
+// with at least one edge, so a graph is connected in Graph::isConnected's
+// sense iff edgeComponents <= 1.
+struct ComponentInfo {
+    std::vector<int> componentOf;
+    std::vector<int> sizes;
+    int count;
+    int edgeComponents;
+};
+
+// k-core decomposition of the simple undirected graph: coreOf[v] is the
+// largest k such that v lies in a subgraph of minimum degree k. order lists
+// the vertices smallest-last (each had the least remaining degree when it
+// was removed), and degeneracy is the largest core number.
+struct CoreDecomposition {
+    std::vector<int> coreOf;
+    std::vector<int> order;
+    int degeneracy;
+};
+
+// A relabeling that maps every graph isomorphic to this one to the same
+// labeled graph, so isomorphic graphs share the hash (see CanonicalLabeler)
+struct CanonicalForm {
+    bool complete;              // False if the search gave up; nothing below is set then
+    std::vector<int> labelOf;   // Original vertex -> canonical label
+    std::vector<int> vertexOf;  // Canonical label -> original vertex
+    uint64_t hash;              // Hash of the relabeled edge list
+
+    CanonicalForm() : complete(false), hash(0) {}
+};
+
+// Data derived from one graph that several algorithms need. Each structure
+// is built on first use and then shared, so the four algorithms a server
+// runs on a request build it at most once between them. Safe to use from
+// several threads at once; the graph must not change while it is in use.
+class GraphAnalysisContext {
+public:
+    explicit GraphAnalysisContext(const Graph& graph) : graph(graph) {}
+
+    GraphAnalysisContext(const GraphAnalysisContext&) = delete;
+    GraphAnalysisContext& operator=(const GraphAnalysisContext&) = delete;
+
+    const Graph& getGraph() const { return graph; }
+
+    // Adjacency list lengths as Graph stores them (out-degree when
+    // directed; a self-loop counts once)
+    const std::vector<int>& degrees();
+    const AdjacencyArray& adjacency();
+    // In-neighbor lists, sorted, in the same form; adjacency() itself when
+    // undirected
+    const AdjacencyArray& inAdjacency();
+    // Parallel Afforest union-find on large graphs (see AfforestComponents)
+    const ComponentInfo& components();
+    // Same as components() for undirected graphs; an edge counts for both
+    // of its endpoints
+    const ComponentInfo& strongComponents();
+    // Over adjacency(), so only meaningful for undirected graphs
+    const CoreDecomposition& cores();
+    // Rows over the original vertex ids, n * n bits: callers bound n
+    const std::vector<Bitset>& bitsetAdjacency();
+    // Searched for at most budget, and never past the deadline or the
+    // cancellation of request; the first caller's limits apply
+    const CanonicalForm& canonicalForm(const ExecutionContext& request, std::chrono::milliseconds budget);
+
+private:
+    const Graph& graph;
+
+    std::once_flag degreesBuilt;
+    std::once_flag adjacencyBuilt;
+    std::once_flag inAdjacencyBuilt;
+    std::once_flag componentsBuilt;
+    std::once_flag strongComponentsBuilt;
+    std::once_flag coresBuilt;
+    std::once_flag bitsetBuilt;
+    std::once_flag canonicalBuilt;
+
+    std::vector<int> degreeList;
+    AdjacencyArray csr;
+    AdjacencyArray inCsr;
+    ComponentInfo componentInfo;
+    ComponentInfo strongComponentInfo;
+    CoreDecomposition coreDecomposition;
+    std::vector<Bitset> bitsetRows;
+    CanonicalForm canonical;
+
+    void buildAdjacency();
+    void buildInAdjacency();
+    void buildComponents();
+    void buildStrongComponents();
+    void buildCores();
+};
+
+#endif
@@ -1,127 +1,388 @@
 #include "Max_clique_algorithm.h"
+#include "ThreadPool.h"
+#include <algorithm>
 #include <chrono>
-#include <sstream>
+#include <memory>
 
-AlgorithmResult MaxCliqueAlgorithm::execute(const Graph& graph) {
+AlgorithmResult MaxCliqueAlgorithm::execute(GraphAnalysisContext& analysis, ExecutionContext& context) {
+    const Graph& graph = analysis.getGraph();
     auto start = std::chrono::high_resolution_clock::now();
     AlgorithmResult result;
-    
+
     try {
         if (graph.isDirected()) {
             result.success = false;
             result.error = "Max clique algorithm works only on undirected graphs";
             return result;
         }
-        
-        if (graph.getVertexCount() > 10) {
-            result.success = false;
-            result.error = "Graph too large for brute force max clique (max 10 vertices)";
-            return result;
+
+        this->context = &context;
+        std::vector<int> originalId;
+        buildOrderedAdjacency(analysis, originalId);
+
+        // Checked after pruning: only the vertices left count. If the context
+        // stopped the pruning itself, nothing is searched.
+        int n = static_cast<int>(originalId.size());
+        bool pruned = n <= maxVertices;
+        if (!pruned) {
+            if (!context.isStopped()) {
+                result.success = false;
+                result.error = "Graph too large for max clique search (max " + std::to_string(maxVertices) + " vertices)";
+                return result;
+            }
+            n = 0;
+        }
+
+        // The search only looks for cliques larger than the greedy one
+        incumbent.store(greedy.empty() ? 0 : (static_cast<uint64_t>(greedy.size()) << 32) | ~0u);
+
+        // Root coloring fixes the branch order; branch k is the k-th vertex
+        // the sequential search would try, with the vertices before it in the
+        // coloring order as its candidates. Those colored too low to branch
+        // on come first.
+        Bitset all(n);
+        for (int i = 0; i < n; i++) {
+            all.set(i);
+        }
+        SearchState rootState{1, 0, false, {}, {}};
+        std::vector<int> order;
+        std::vector<int> colors;
+        colorSort(rootState, all, order, colors);
+
+        int branches = static_cast<int>(order.size());
+        std::vector<SearchState> states(branches);
+        std::vector<Bitset> earlier(branches, Bitset(n));
+        Bitset prefix = all;
+        for (int v : order) {
+            prefix.reset(v);
+        }
+        for (int i = 0; i < branches; i++) {
+            earlier[i] = prefix;
+            prefix.set(order[i]);
         }
-        
-        std::vector<int> currentClique;
-        std::vector<int> candidates;
-        std::vector<int> maxClique;
-        
-        // Initialize candidates with all vertices
-        for (int i = 0; i < graph.getVertexCount(); i++) {
-            candidates.push_back(i);
-        }
-        
-        findMaxClique(graph, currentClique, candidates, maxClique);
-        
-        std::ostringstream output;
-        output << "Size: " << maxClique.size();
-        
-        if (!maxClique.empty() && maxClique.size() <= 8) {
-            output << " - Vertices: {";
-            for (size_t i = 0; i < maxClique.size(); i++) {
-                output << maxClique[i];
-                if (i < maxClique.size() - 1) output << ",";
+
+        auto runBranch = [&](int k) {
+            int i = branches - 1 - k;
+            states[k].taskIndex = static_cast<uint32_t>(k + 1);
+            searchRoot(states[k], order[i], earlier[i], colors[i]);
+            states[k].finished = !context.isStopped();
+        };
+
+        ThreadPool& pool = ThreadPool::shared();
+        if (n >= PARALLEL_MIN_VERTICES && pool.size() > 1) {
+            TaskGroup group(pool);
+            for (int k = 0; k < branches; k++) {
+                group.run([&runBranch, k]() { runBranch(k); });
+            }
+            group.wait();
+        } else {
+            for (int k = 0; k < branches && !context.isStopped(); k++) {
+                runBranch(k);
             }
-            output << "}";
         }
-        
+
+        // Largest clique, earliest branch on ties: what the sequential search
+        // reports. A branch may also keep a smaller clique it came across, so
+        // the greedy clique stands unless some branch beat it.
+        const std::vector<int>* maxClique = nullptr;
+        size_t maxSize = greedy.size();
+        for (const auto& state : states) {
+            if (state.bestClique.size() > maxSize) {
+                maxClique = &state.bestClique;
+                maxSize = state.bestClique.size();
+            }
+        }
+
+        // Stopped early: report the best clique known and what is still
+        // possible. A branch that did not finish can reach at most its root
+        // color; no clique exceeds the degeneracy plus one, the only bound
+        // left when the pruning was stopped.
+        bool exact = !context.isStopped();
+        int upperBound = 0;
+        if (!exact) {
+            upperBound = static_cast<int>(maxSize);
+            for (int k = 0; k < branches; k++) {
+                if (!states[k].finished) {
+                    upperBound = std::max(upperBound, colors[branches - 1 - k]);
+                }
+            }
+            upperBound = pruned ? std::min(upperBound, degeneracy + 1) : degeneracy + 1;
+        }
+
+        result.kind = ResultKind::CLIQUE;
+        if (maxClique) {
+            for (int v : *maxClique) {
+                result.vertices.push_back(originalId[v]);
+            }
+        } else {
+            result.vertices = greedy;
+        }
+        std::sort(result.vertices.begin(), result.vertices.end());
         result.success = true;
-        result.result = output.str();
-        
+        if (!exact) {
+            result.upperBound = upperBound;
+            result.interrupted = true;
+            result.markPartial(context.describeStop());
+        }
+
     } catch (const std::exception& e) {
         result.success = false;
         result.error = e.what();
     }
-    
+
     auto end = std::chrono::high_resolution_clock::now();
     result.executionTime = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
-    
+
     return result;
 }
 
-void MaxCliqueAlgorithm::findMaxClique(const Graph& graph, std::vector<int>& currentClique, 
-                                     std::vector<int>& candidates, std::vector<int>& maxClique) {
-    if (candidates.empty()) {
-        if (currentClique.size() > maxClique.size()) {
-            maxClique = currentClique;
+// Renumber vertices in reverse smallest-last (degeneracy) order, so the dense
+// core gets the lowest ids and is colored first, then build bitset rows.
+//
+// Once a greedy clique of size g is known, the search only has to find one
+// of g + 1 vertices. Such a clique lies in the g-core, so every vertex of
+// core number below g is dropped before any bitset is allocated.
+void MaxCliqueAlgorithm::buildOrderedAdjacency(GraphAnalysisContext& analysis, std::vector<int>& originalId) {
+    const AdjacencyArray& neighbors = analysis.adjacency();
+    const CoreDecomposition& cores = analysis.cores();
+    int n = static_cast<int>(cores.order.size());
+    degeneracy = cores.degeneracy;
+
+    greedy = greedyClique(neighbors, cores.order);
+    int minCore = static_cast<int>(greedy.size());
+
+    originalId.clear();
+    for (auto it = cores.order.rbegin(); it != cores.order.rend(); ++it) {
+        if (cores.coreOf[*it] >= minCore) {
+            originalId.push_back(*it);
         }
-        return;
     }
-    
-    // Pruning: if current + candidates can't beat max, return
-    if (currentClique.size() + candidates.size() <= maxClique.size()) {
-        return;
+    int kept = static_cast<int>(originalId.size());
+    std::vector<int> newId(n, -1);
+    for (int i = 0; i < kept; i++) {
+        newId[originalId[i]] = i;
     }
-    
-    int vertex = candidates[0];
-    candidates.erase(candidates.begin());
-    
-    // Try including this vertex
-    currentClique.push_back(vertex);
-    std::vector<int> newCandidates = getCommonNeighbors(graph, std::vector<int>{vertex});
-    
-    // Keep only candidates that are neighbors of all vertices in current clique
-    std::vector<int> validCandidates;
-    for (int candidate : candidates) {
-        bool isNeighborOfAll = true;
-        for (int cliqueVertex : currentClique) {
-            if (!graph.hasEdge(candidate, cliqueVertex)) {
-                isNeighborOfAll = false;
-                break;
-            }
+
+    // Edges between kept vertices, each listed at its higher new id: a
+    // vertex had at most degeneracy neighbors left when it was removed
+    AdjacencyArray lower;
+    lower.offsets.assign(kept + 1, 0);
+    for (int i = 0; i < kept; i++) {
+        int v = originalId[i];
+        for (const int* u = neighbors.begin(v); u != neighbors.end(v); ++u) {
+            if (newId[*u] >= 0 && newId[*u] < i) lower.targets.push_back(newId[*u]);
         }
-        if (isNeighborOfAll) {
-            validCandidates.push_back(candidate);
+        lower.offsets[i + 1] = static_cast<int>(lower.targets.size());
+    }
+    if (kept > maxVertices) {
+        dropUnsupportedEdges(lower, originalId, minCore + 1);
+        kept = static_cast<int>(originalId.size());
+    }
+
+    // Callers check kept against the vertex limit before searching
+    adjacency.clear();
+    if (kept > maxVertices) return;
+    adjacency.assign(kept, Bitset(kept));
+    for (int i = 0; i < kept; i++) {
+        for (const int* j = lower.begin(i); j != lower.end(i); ++j) {
+            adjacency[i].set(*j);
+            adjacency[*j].set(i);
         }
     }
-    
-    findMaxClique(graph, currentClique, validCandidates, maxClique);
-    
-    // Backtrack
-    currentClique.pop_back();
-    
-    // Try not including this vertex
-    findMaxClique(graph, currentClique, candidates, maxClique);
 }
 
-std::vector<int> MaxCliqueAlgorithm::getCommonNeighbors(const Graph& graph, const std::vector<int>& vertices) {
-    std::vector<int> commonNeighbors;
-    
-    if (vertices.empty()) return commonNeighbors;
-    
-    // Get neighbors of first vertex
-    std::vector<int> firstNeighbors = graph.getNeighbors(vertices[0]);
-    
-    // Check which neighbors are common to all vertices
-    for (int neighbor : firstNeighbors) {
-        bool isCommon = true;
-        for (size_t i = 1; i < vertices.size(); i++) {
-            if (!graph.hasEdge(vertices[i], neighbor)) {
-                isCommon = false;
-                break;
+// In a clique of cliqueSize vertices every edge is on cliqueSize - 2 of its
+// triangles and every vertex has cliqueSize - 1 of its edges. Sparse graphs
+// can have a large core with few triangles, so when the core filter leaves
+// too many vertices, the triangles of lower are listed (each once, from its
+// highest vertex, O(E * degeneracy)), edges on too few of them are dropped,
+// and so are the vertices left with too few edges. Stops, leaving the
+// vertices as they were, when the context does.
+void MaxCliqueAlgorithm::dropUnsupportedEdges(AdjacencyArray& lower, std::vector<int>& originalId, int cliqueSize) {
+    int kept = static_cast<int>(originalId.size());
+    std::vector<int> support(lower.targets.size(), 0);
+    std::vector<int> slotOf(kept, -1);
+    long long steps = 0;
+    for (int i = 0; i < kept; i++) {
+        for (int s = lower.offsets[i]; s < lower.offsets[i + 1]; s++) {
+            slotOf[lower.targets[s]] = s;
+        }
+        for (int s = lower.offsets[i]; s < lower.offsets[i + 1]; s++) {
+            int j = lower.targets[s];
+            for (int t = lower.offsets[j]; t < lower.offsets[j + 1]; t++) {
+                int third = slotOf[lower.targets[t]];
+                if (third >= 0) {
+                    support[s]++;
+                    support[t]++;
+                    support[third]++;
+                }
             }
+            steps += lower.degree(j);
         }
-        if (isCommon) {
-            commonNeighbors.push_back(neighbor);
+        for (int s = lower.offsets[i]; s < lower.offsets[i + 1]; s++) {
+            slotOf[lower.targets[s]] = -1;
         }
+
+        steps += lower.degree(i) + 1;
+        if (steps >= POLL_INTERVAL) {
+            if (context->charge(steps)) return;
+            steps = 0;
+        }
+    }
+
+    std::vector<int> degree(kept, 0);
+    for (int i = 0; i < kept; i++) {
+        for (int s = lower.offsets[i]; s < lower.offsets[i + 1]; s++) {
+            if (support[s] >= cliqueSize - 2) {
+                degree[i]++;
+                degree[lower.targets[s]]++;
+            }
+        }
+    }
+
+    // Survivors keep their relative order, so lower ids stay lower
+    std::vector<int> newId(kept, -1);
+    std::vector<int> survivors;
+    for (int i = 0; i < kept; i++) {
+        if (degree[i] >= cliqueSize - 1) {
+            newId[i] = static_cast<int>(survivors.size());
+            survivors.push_back(originalId[i]);
+        }
+    }
+    AdjacencyArray pruned;
+    pruned.offsets.assign(survivors.size() + 1, 0);
+    for (int i = 0; i < kept; i++) {
+        if (newId[i] < 0) continue;
+        for (int s = lower.offsets[i]; s < lower.offsets[i + 1]; s++) {
+            int j = lower.targets[s];
+            if (support[s] >= cliqueSize - 2 && newId[j] >= 0) pruned.targets.push_back(newId[j]);
+        }
+        pruned.offsets[newId[i] + 1] = static_cast<int>(pruned.targets.size());
+    }
+    lower = std::move(pruned);
+    originalId = std::move(survivors);
+}
+
+// Greedy clique along the reverse smallest-last order, densest core first:
+// a vertex joins if it is adjacent to every vertex taken so far. O(V + E)
+// over the adjacency arrays, in original vertex ids.
+std::vector<int> MaxCliqueAlgorithm::greedyClique(const AdjacencyArray& neighbors, const std::vector<int>& order) {
+    std::vector<int> clique;
+    std::vector<int> adjacentTo(order.size(), 0);
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        int v = *it;
+        if (adjacentTo[v] != static_cast<int>(clique.size())) continue;
+        clique.push_back(v);
+        for (const int* u = neighbors.begin(v); u != neighbors.end(v); ++u) {
+            adjacentTo[*u]++;
+        }
+    }
+    return clique;
+}
+
+// Smallest clique size worth reaching from this state. The task's own best
+// is beaten only strictly; another task's clique of equal size only counts if
+// that task comes first in sequential order.
+int MaxCliqueAlgorithm::targetSize(const SearchState& state) const {
+    uint64_t packed = incumbent.load(std::memory_order_relaxed);
+    int globalSize = static_cast<int>(packed >> 32);
+    uint32_t globalTask = ~static_cast<uint32_t>(packed);
+
+    int target = static_cast<int>(state.bestClique.size()) + 1;
+    if (globalSize > 0) {
+        target = std::max(target, globalTask < state.taskIndex ? globalSize + 1 : globalSize);
+    }
+    return target;
+}
+
+void MaxCliqueAlgorithm::publish(SearchState& state) {
+    state.bestClique = state.currentClique;
+
+    uint64_t packed = (static_cast<uint64_t>(state.bestClique.size()) << 32) | ~state.taskIndex;
+    uint64_t seen = incumbent.load(std::memory_order_relaxed);
+    while (seen < packed && !incumbent.compare_exchange_weak(seen, packed, std::memory_order_relaxed)) {
+    }
+}
+
+// Counts one search node; charges the context once per POLL_INTERVAL nodes
+bool MaxCliqueAlgorithm::shouldStop(SearchState& state) {
+    if (++state.steps == POLL_INTERVAL) {
+        state.steps = 0;
+        context->charge(POLL_INTERVAL);
+    }
+    return context->isStopped();
+}
+
+void MaxCliqueAlgorithm::searchRoot(SearchState& state, int vertex, const Bitset& earlier, int rootColor) {
+    if (shouldStop(state) || rootColor < targetSize(state)) {
+        return;
+    }
+
+    state.currentClique.assign(1, vertex);
+    Bitset candidates;
+    Bitset::intersect(earlier, adjacency[vertex], candidates);
+    if (!candidates.any()) {
+        publish(state);
+    } else {
+        expand(state, candidates);
     }
+    state.currentClique.clear();
+}
+
+// Greedy sequential coloring of the candidates. Vertices come out grouped by
+// color, ascending, and colors[i] bounds the clique size reachable from
+// order[0..i]. Vertices whose color cannot reach the target are omitted.
+void MaxCliqueAlgorithm::colorSort(const SearchState& state, const Bitset& candidates,
+                                   std::vector<int>& order, std::vector<int>& colors) {
+    order.clear();
+    colors.clear();
+
+    int minUsefulColor = targetSize(state) - static_cast<int>(state.currentClique.size());
+
+    Bitset uncolored = candidates;
+    Bitset colorClass;
+    int color = 0;
+    while (uncolored.any()) {
+        color++;
+        colorClass = uncolored;
+        for (int v = colorClass.first(); v != -1; v = colorClass.next(v + 1)) {
+            uncolored.reset(v);
+            colorClass.subtract(adjacency[v]);
+            if (color >= minUsefulColor) {
+                order.push_back(v);
+                colors.push_back(color);
+            }
+        }
+    }
+}
+
+void MaxCliqueAlgorithm::expand(SearchState& state, Bitset& candidates) {
+    if (shouldStop(state)) return;
     
-    return commonNeighbors;
-}
\ No newline at end of file
+    std::vector<int> order;
+    std::vector<int> colors;
+    colorSort(state, candidates, order, colors);
+
+    Bitset newCandidates;
+    for (int i = static_cast<int>(order.size()) - 1; i >= 0; i--) {
+        // Bound: even using every remaining color class we cannot reach the target
+        if (static_cast<int>(state.currentClique.size()) + colors[i] < targetSize(state)) {
+            return;
+        }
+
+        int v = order[i];
+        state.currentClique.push_back(v);
+
+        Bitset::intersect(candidates, adjacency[v], newCandidates);
+        if (!newCandidates.any()) {
+            if (state.currentClique.size() > state.bestClique.size()) {
+                publish(state);
+            }
+        } else {
+            expand(state, newCandidates);
+        }
+
+        state.currentClique.pop_back();
+        candidates.reset(v);
+    }
+}
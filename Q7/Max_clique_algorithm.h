@@ -2,19 +2,73 @@
 #define MAX_CLIQUE_ALGORITHM_H
 
 #include "BaseAlgorithm.h"
+#include "Bitset.h"
+#include <atomic>
+#include <cstdint>
 #include <vector>
 
+// Exact maximum clique by branch and bound (Tomita MCQ/MCR style): vertices
+// are renumbered in smallest-last order, candidate sets are bitsets, and a
+// greedy coloring of the candidates bounds how large a clique each branch
+// can still reach. A greedy clique seeds the search, so only vertices that
+// can be in a larger clique are kept: those of high enough core number (see
+// GraphAnalysisContext::cores()) and, when that leaves too many, on enough
+// triangles. The vertex limit applies to what is left.
+//
+// The root branches run as tasks on the shared work-stealing pool. All tasks
+// prune against one atomic incumbent; ties are broken by task order, so the
+// reported clique is the same one the sequential search would find.
+//
+// If the execution context stops the search, the result is the best clique
+// found so far (at least the greedy one) with a proven upper bound, marked as
+// not exact.
 class MaxCliqueAlgorithm : public BaseAlgorithm {
 public:
-    AlgorithmResult execute(const Graph& graph) override;
+    static constexpr int DEFAULT_MAX_VERTICES = 1000;
+    static constexpr int PARALLEL_MIN_VERTICES = 64;
+    // Search nodes between checks of the execution context
+    static constexpr int POLL_INTERVAL = 1024;
+
+    explicit MaxCliqueAlgorithm(int maxVertices = DEFAULT_MAX_VERTICES)
+        : maxVertices(maxVertices), degeneracy(0), context(nullptr) {}
+
+    using BaseAlgorithm::execute;
+    AlgorithmResult execute(GraphAnalysisContext& analysis, ExecutionContext& context) override;
     std::string getName() const override { return "Maximum Clique"; }
     bool supportsDirected() const override { return false; }
     bool supportsUndirected() const override { return true; }
 
 private:
-    void findMaxClique(const Graph& graph, std::vector<int>& currentClique, 
-                      std::vector<int>& candidates, std::vector<int>& maxClique);
-    std::vector<int> getCommonNeighbors(const Graph& graph, const std::vector<int>& vertices);
+    // State of one root-branch task, in renumbered vertex ids
+    struct SearchState {
+        uint32_t taskIndex;
+        int steps;                  // Nodes since the last charge to the context
+        bool finished;              // Branch searched to completion
+        std::vector<int> currentClique;
+        std::vector<int> bestClique;
+    };
+
+    int maxVertices;
+    std::vector<Bitset> adjacency;
+    std::vector<int> greedy;            // Greedy clique, original ids
+    int degeneracy;
+    ExecutionContext* context;
+
+    // Best (size, task) found by any task, packed as size << 32 | ~taskIndex
+    // so a plain numeric max prefers larger cliques, then earlier tasks.
+    // Task 0 is the greedy clique; the root branches are tasks 1, 2, ...
+    std::atomic<uint64_t> incumbent;
+
+    void buildOrderedAdjacency(GraphAnalysisContext& analysis, std::vector<int>& originalId);
+    void dropUnsupportedEdges(AdjacencyArray& lower, std::vector<int>& originalId, int cliqueSize);
+    void searchRoot(SearchState& state, int vertex, const Bitset& earlier, int rootColor);
+    void expand(SearchState& state, Bitset& candidates);
+    void colorSort(const SearchState& state, const Bitset& candidates,
+                   std::vector<int>& order, std::vector<int>& colors);
+    static std::vector<int> greedyClique(const AdjacencyArray& neighbors, const std::vector<int>& order);
+    int targetSize(const SearchState& state) const;
+    bool shouldStop(SearchState& state);
+    void publish(SearchState& state);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -1,9 +1,12 @@
 #include "Mst_algorithm.h"
+#include "boruvka_mst.h"
+#include "prim_mst.h"
+#include "ThreadPool.h"
 #include <chrono>
 #include <algorithm>
-#include <sstream>
 
-AlgorithmResult MSTAlgorithm::execute(const Graph& graph) {
+AlgorithmResult MSTAlgorithm::execute(GraphAnalysisContext& analysis, ExecutionContext& context) {
+    const Graph& graph = analysis.getGraph();
     auto start = std::chrono::high_resolution_clock::now();
     AlgorithmResult result;
     
@@ -14,65 +17,56 @@ AlgorithmResult MSTAlgorithm::execute(const Graph& graph) {
             return result;
         }
         
-        if (!graph.isConnected()) {
-            result.success = false;
-            result.error = "Graph must be connected for MST";
-            return result;
-        }
-        
         int n = graph.getVertexCount();
+        result.kind = ResultKind::SPANNING_TREE;
         if (n <= 1) {
             result.success = true;
-            result.result = "Weight: 0 (trivial case)";
             return result;
         }
         
-        // Get edges with uniform weights (weight = 1 for simplicity)
-        std::vector<Edge> edges = getEdgesWithWeights(graph);
-        
-        // Sort edges by weight (all are 1, so no change needed)
-        std::sort(edges.begin(), edges.end());
-        
-        // Kruskal's algorithm with Union-Find
-        std::vector<int> parent(n);
-        std::vector<int> rank(n, 0);
-        for (int i = 0; i < n; i++) {
-            parent[i] = i;
-        }
-        
-        int totalWeight = 0;
-        int edgesUsed = 0;
-        std::vector<Edge> mstEdges;
+        // One tree per component; isolated vertices contribute no edges
+        const ComponentInfo& components = analysis.components();
+        int forestSize = n - components.count;
         
-        for (const Edge& edge : edges) {
-            int rootU = find(parent, edge.u);
-            int rootV = find(parent, edge.v);
-            
-            if (rootU != rootV) {
-                unite(parent, rank, edge.u, edge.v);
-                totalWeight += edge.weight;
-                mstEdges.push_back(edge);
-                edgesUsed++;
-                
-                if (edgesUsed == n - 1) break; // MST is complete
+        const AdjacencyArray& adjacency = analysis.adjacency();
+        std::vector<Edge> forest;
+        forest.reserve(forestSize);
+        Engine engine = chooseEngine(n, graph.getEdgeCount());
+        bool finished = false;
+        switch (engine) {
+            case Engine::ARRAY_PRIM:
+            case Engine::HEAP_PRIM: {
+                // Uniform weights (weight = 1 for simplicity), laid out like the adjacency
+                std::vector<int> weights(adjacency.targets.size(), 1);
+                PrimMST::Variant variant = engine == Engine::ARRAY_PRIM ? PrimMST::Variant::ARRAY
+                                                                        : PrimMST::Variant::HEAP;
+                finished = PrimMST::run(adjacency, weights, variant, forest, context);
+                break;
+            }
+            case Engine::BORUVKA: {
+                std::vector<Edge> edges = getEdgesWithWeights(adjacency);
+                finished = BoruvkaMST::run(n, edges, forest, context);
+                break;
+            }
+            case Engine::KRUSKAL: {
+                std::vector<Edge> edges = getEdgesWithWeights(adjacency);
+                finished = kruskal(n, edges, forestSize, forest, context);
+                break;
             }
         }
         
-        std::ostringstream output;
-        output << "Weight: " << totalWeight;
-        output << " (Edges: " << edgesUsed << ")";
-        
-        if (mstEdges.size() <= 8) {
-            output << " - MST edges: ";
-            for (size_t i = 0; i < mstEdges.size(); i++) {
-                output << mstEdges[i].u << "-" << mstEdges[i].v;
-                if (i < mstEdges.size() - 1) output << ",";
+        if (!finished) {
+            result.markInterrupted(context);
+        } else {
+            result.edges.reserve(forest.size());
+            for (const Edge& edge : forest) {
+                result.weight += edge.weight;
+                result.edges.emplace_back(edge.u, edge.v);
             }
+            result.trees = components.edgeComponents;
+            result.success = true;
         }
         
-        result.success = true;
-        result.result = output.str();
-        
     } catch (const std::exception& e) {
         result.success = false;
         result.error = e.what();
@@ -84,6 +78,55 @@ AlgorithmResult MSTAlgorithm::execute(const Graph& graph) {
     return result;
 }
 
+// Prim when the graph is dense enough for it to win, otherwise Kruskal, or
+// Borůvka for large edge sets when there are cores to spread them over
+MSTAlgorithm::Engine MSTAlgorithm::chooseEngine(int n, long long edgeCount) {
+    if (n < PRIM_MIN_VERTICES) {
+        return Engine::KRUSKAL;
+    }
+    double pairs = 0.5 * n * (n - 1.0);
+    double density = pairs > 0 ? edgeCount / pairs : 0.0;
+    if (density >= ARRAY_PRIM_MIN_DENSITY) {
+        return Engine::ARRAY_PRIM;
+    }
+    if (static_cast<size_t>(edgeCount) >= PARALLEL_MIN_EDGES && ThreadPool::shared().size() > 1) {
+        return Engine::BORUVKA;
+    }
+    if (2.0 * edgeCount / n >= HEAP_PRIM_MIN_AVERAGE_DEGREE) {
+        return Engine::HEAP_PRIM;
+    }
+    return Engine::KRUSKAL;
+}
+
+bool MSTAlgorithm::kruskal(int n, std::vector<Edge>& edges, int forestSize, std::vector<Edge>& forest,
+                           ExecutionContext& context) {
+    std::sort(edges.begin(), edges.end());
+    
+    std::vector<int> parent(n);
+    std::vector<int> rank(n, 0);
+    for (int i = 0; i < n; i++) {
+        parent[i] = i;
+    }
+    
+    if (context.check()) return false;
+    size_t scanned = 0;
+    for (const Edge& edge : edges) {
+        if (static_cast<int>(forest.size()) == forestSize) break; // Forest is complete
+        if (++scanned % POLL_INTERVAL == 0 && context.charge(POLL_INTERVAL)) {
+            return false;
+        }
+        
+        int rootU = find(parent, edge.u);
+        int rootV = find(parent, edge.v);
+        
+        if (rootU != rootV) {
+            unite(parent, rank, edge.u, edge.v);
+            forest.push_back(edge);
+        }
+    }
+    return true;
+}
+
 int MSTAlgorithm::find(std::vector<int>& parent, int x) {
     if (parent[x] != x) {
         parent[x] = find(parent, parent[x]); // Path compression
@@ -105,18 +148,19 @@ void MSTAlgorithm::unite(std::vector<int>& parent, std::vector<int>& rank, int x
     }
 }
 
-std::vector<Edge> MSTAlgorithm::getEdgesWithWeights(const Graph& graph) {
+std::vector<Edge> MSTAlgorithm::getEdgesWithWeights(const AdjacencyArray& adjacency) {
     std::vector<Edge> edges;
+    edges.reserve(adjacency.targets.size() / 2);
     
     // Since our graph doesn't have weights, assign weight 1 to all edges
-    for (int u = 0; u < graph.getVertexCount(); u++) {
-        std::vector<int> neighbors = graph.getNeighbors(u);
-        for (int v : neighbors) {
-            if (u < v) { // Avoid duplicates in undirected graph
-                edges.emplace_back(u, v, 1);
+    int n = static_cast<int>(adjacency.offsets.size()) - 1;
+    for (int u = 0; u < n; u++) {
+        for (const int* v = adjacency.begin(u); v != adjacency.end(u); ++v) {
+            if (u < *v) { // Avoid duplicates in undirected graph
+                edges.emplace_back(u, *v, 1);
             }
         }
     }
     
     return edges;
-}
\ No newline at end of file
+}
@@ -10,17 +10,39 @@ struct Edge {
     bool operator<(const Edge& other) const { return weight < other.weight; }
 };
 
+// Minimum spanning forest: one tree per connected component. The engine
+// follows the edge density:
+//   - very dense graphs: array-based Prim (prim_mst.h), O(V^2),
+//   - edge sets from PARALLEL_MIN_EDGES up, when the shared pool has more
+//     than one thread: parallel Borůvka (boruvka_mst.h),
+//   - average degree from HEAP_PRIM_MIN_AVERAGE_DEGREE up: Prim with an
+//     indexed d-ary heap,
+//   - anything sparser, and graphs below PRIM_MIN_VERTICES: Kruskal.
 class MSTAlgorithm : public BaseAlgorithm {
 public:
-    AlgorithmResult execute(const Graph& graph) override;
+    enum class Engine { KRUSKAL, HEAP_PRIM, ARRAY_PRIM, BORUVKA };
+    
+    // Edges scanned between checks of the execution context
+    static constexpr size_t POLL_INTERVAL = 4096;
+    static constexpr size_t PARALLEL_MIN_EDGES = 100000;
+    static constexpr int PRIM_MIN_VERTICES = 64;
+    static constexpr double ARRAY_PRIM_MIN_DENSITY = 0.25;
+    static constexpr double HEAP_PRIM_MIN_AVERAGE_DEGREE = 16.0;
+    
+    static Engine chooseEngine(int n, long long edgeCount);
+    
+    using BaseAlgorithm::execute;
+    AlgorithmResult execute(GraphAnalysisContext& analysis, ExecutionContext& context) override;
     std::string getName() const override { return "Minimum Spanning Tree Weight"; }
     bool supportsDirected() const override { return false; }
     bool supportsUndirected() const override { return true; }
 
 private:
+    bool kruskal(int n, std::vector<Edge>& edges, int forestSize, std::vector<Edge>& forest,
+                 ExecutionContext& context);
     int find(std::vector<int>& parent, int x);
     void unite(std::vector<int>& parent, std::vector<int>& rank, int x, int y);
-    std::vector<Edge> getEdgesWithWeights(const Graph& graph);
+    std::vector<Edge> getEdgesWithWeights(const AdjacencyArray& adjacency);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include "ResultCache.h"
+#include <algorithm>
+
+ResultCache::ResultCache(size_t capacityBytes)
+    : capacity(capacityBytes), shardCapacity(capacityBytes / SHARD_COUNT),
+      hits(0), canonicalHits(0), misses(0), evictions(0) {
+    for (size_t i = 0; i < SHARD_COUNT; i++) {
+        shards.push_back(std::make_unique<Shard>());
+    }
+}
+
+ResultCache::Key ResultCache::makeKey(const Graph& graph, AlgorithmType algorithm) {
+    return Key{graph.getHash(), graph.getVertexCount(), graph.getEdgeCount(),
+               graph.isDirected(), false, algorithm};
+}
+
+ResultCache::Key ResultCache::makeCanonicalKey(const Graph& graph, const CanonicalForm& form,
+                                               AlgorithmType algorithm) {
+    return Key{form.hash, graph.getVertexCount(), graph.getEdgeCount(),
+               graph.isDirected(), true, algorithm};
+}
+
+size_t ResultCache::KeyHash::operator()(const Key& key) const {
+    // The Zobrist hash is already well mixed; fold the algorithm in so the
+    // four results of one graph spread over different shards
+    uint64_t h = key.fingerprint ^ (static_cast<uint64_t>(key.algorithm) + 1) * 0x9e3779b97f4a7c15ULL;
+    h ^= key.canonical ? 0xc2b2ae3d27d4eb4fULL : 0;
+    return static_cast<size_t>(h ^ (h >> 29));
+}
+
+ResultCache::Shard& ResultCache::shardFor(const Key& key) {
+    return *shards[KeyHash()(key) % SHARD_COUNT];
+}
+
+bool ResultCache::lookup(const Key& key, AlgorithmResult& result) {
+    if (!isEnabled()) return false;
+
+    Shard& shard = shardFor(key);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto found = shard.index.find(key);
+        if (found != shard.index.end()) {
+            shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+            result = found->second->result;
+            hits++;
+            if (key.canonical) canonicalHits++;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ResultCache::insert(const Key& key, const AlgorithmResult& result) {
+    if (!isEnabled() || !result.success || !result.exact || result.interrupted) return;
+
+    size_t bytes = estimateBytes(result);
+    if (bytes > shardCapacity) return;
+
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto found = shard.index.find(key);
+    if (found != shard.index.end()) {
+        // Another request finished the same graph first; its answer is as good
+        shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+        return;
+    }
+
+    shard.entries.push_front(Entry{key, result, bytes});
+    shard.index.emplace(key, shard.entries.begin());
+    shard.bytes += bytes;
+
+    while (shard.bytes > shardCapacity) {
+        Entry& oldest = shard.entries.back();
+        shard.bytes -= oldest.bytes;
+        shard.index.erase(oldest.key);
+        shard.entries.pop_back();
+        evictions++;
+    }
+}
+
+ResultCache::Stats ResultCache::getStats() const {
+    Stats stats;
+    stats.hits = hits.load();
+    stats.canonicalHits = canonicalHits.load();
+    stats.misses = misses.load();
+    stats.evictions = evictions.load();
+    stats.entries = 0;
+    stats.bytes = 0;
+    stats.capacity = capacity;
+    for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        stats.entries += shard->entries.size();
+        stats.bytes += shard->bytes;
+    }
+    return stats;
+}
+
+void ResultCache::relabel(AlgorithmResult& result, const std::vector<int>& newId) {
+    if (!result.values.empty()) {
+        std::vector<double> moved(result.values.size());
+        for (size_t v = 0; v < result.values.size(); v++) {
+            moved[newId[v]] = result.values[v];
+        }
+        result.values.swap(moved);
+    }
+    if (result.kind == ResultKind::STRONG_COMPONENTS || result.kind == ResultKind::COMPONENTS) {
+        // vertices is indexed by vertex: move the entries, then number the
+        // components by smallest member again
+        std::vector<int> moved(result.vertices.size());
+        for (size_t v = 0; v < result.vertices.size(); v++) {
+            moved[newId[v]] = result.vertices[v];
+        }
+        std::vector<int> renumber(result.trees, -1);
+        int next = 0;
+        for (int& component : moved) {
+            if (renumber[component] < 0) renumber[component] = next++;
+            component = renumber[component];
+        }
+        result.vertices.swap(moved);
+        return;
+    }
+    if (result.kind == ResultKind::CORES) {
+        std::vector<int> moved(result.vertices.size());
+        for (size_t v = 0; v < result.vertices.size(); v++) {
+            moved[newId[v]] = result.vertices[v];
+        }
+        result.vertices.swap(moved);
+        return;
+    }
+    for (int& v : result.vertices) {
+        v = newId[v];
+    }
+    for (auto& edge : result.edges) {
+        edge = {newId[edge.first], newId[edge.second]};
+    }
+    // Keep the sets the algorithms print in their usual order
+    if (result.kind == ResultKind::CLIQUE || result.kind == ResultKind::DIAMETER) {
+        std::sort(result.vertices.begin(), result.vertices.end());
+    } else if (result.kind == ResultKind::SPANNING_TREE) {
+        for (auto& edge : result.edges) {
+            if (edge.first > edge.second) std::swap(edge.first, edge.second);
+        }
+        std::sort(result.edges.begin(), result.edges.end());
+    }
+}
+
+size_t ResultCache::estimateBytes(const AlgorithmResult& result) {
+    // List node, index node and bucket, plus what the result owns
+    size_t bytes = sizeof(Entry) + 4 * sizeof(void*) + sizeof(std::pair<const Key, void*>);
+    bytes += result.vertices.capacity() * sizeof(int);
+    bytes += result.edges.capacity() * sizeof(std::pair<int, int>);
+    bytes += result.values.capacity() * sizeof(double);
+    bytes += result.error.capacity();
+    return bytes;
+}
+
+ResultCache& ResultCache::shared() {
+    static ResultCache cache(static_cast<size_t>(AlgorithmFactory::getConfig().resultCacheMb) << 20);
+    return cache;
+}
@@ -0,0 +1,122 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include "AlgorithmFactory.h"
+#include "Graph.h"
+#include "GraphAnalysisContext.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Finished results by graph and algorithm, shared by every connection of a
+// server process so a graph that is sent again is answered without running
+// the algorithms again.
+//
+// The cache is split into shards by key, each an LRU list behind its own
+// mutex, so lookups from different requests rarely wait on each other. Its
+// size is a memory budget: every entry is charged an estimate of what it
+// holds, and the least recently used entries of a shard are dropped once the
+// shard is over its share of the budget.
+//
+// Results are found by the graph's exact edge hash or, for a graph with a
+// canonical form, by the canonical hash. Canonical entries hold the result
+// relabeled into canonical vertex numbers, so a graph that only differs in
+// numbering maps them back through its own labeling.
+//
+// Only exact results are kept. A result cut short by a deadline or budget
+// depends on the request, not just the graph, and is never stored.
+class ResultCache {
+public:
+    struct Key {
+        uint64_t fingerprint;
+        int vertices;
+        int edges;
+        bool directed;
+        bool canonical;
+        AlgorithmType algorithm;
+
+        bool operator==(const Key& other) const {
+            return fingerprint == other.fingerprint && vertices == other.vertices &&
+                   edges == other.edges && directed == other.directed &&
+                   canonical == other.canonical && algorithm == other.algorithm;
+        }
+    };
+
+    struct Stats {
+        long long hits;
+        long long canonicalHits;    // Hits on an isomorphic graph, included in hits
+        long long misses;
+        long long evictions;
+        size_t entries;
+        size_t bytes;
+        size_t capacity;
+    };
+
+    static constexpr size_t SHARD_COUNT = 16;
+
+    // A capacity of 0 disables the cache
+    explicit ResultCache(size_t capacityBytes);
+
+    ResultCache(const ResultCache&) = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+
+    // Keyed by Graph's incrementally maintained edge hash, so building a key
+    // costs nothing beyond the edge count
+    static Key makeKey(const Graph& graph, AlgorithmType algorithm);
+    static Key makeCanonicalKey(const Graph& graph, const CanonicalForm& form, AlgorithmType algorithm);
+
+    // Copies the cached result into result and counts a hit
+    bool lookup(const Key& key, AlgorithmResult& result);
+    // Counts a request that had to be computed
+    void recordMiss() { misses++; }
+    // Stores result if it is worth keeping (see above)
+    void insert(const Key& key, const AlgorithmResult& result);
+
+    // Renames every vertex v in result to newId[v]
+    static void relabel(AlgorithmResult& result, const std::vector<int>& newId);
+
+    bool isEnabled() const { return capacity > 0; }
+    Stats getStats() const;
+
+    // The process-wide cache, sized from AlgorithmFactory's config on first use
+    static ResultCache& shared();
+
+private:
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        Key key;
+        AlgorithmResult result;
+        size_t bytes;
+    };
+
+    // Front of entries is the most recently used
+    struct Shard {
+        mutable std::mutex mutex;
+        std::list<Entry> entries;
+        std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+        size_t bytes = 0;
+    };
+
+    size_t capacity;
+    size_t shardCapacity;
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    std::atomic<long long> hits;
+    std::atomic<long long> canonicalHits;
+    std::atomic<long long> misses;
+    std::atomic<long long> evictions;
+
+    Shard& shardFor(const Key& key);
+    static size_t estimateBytes(const AlgorithmResult& result);
+};
+
+#endif
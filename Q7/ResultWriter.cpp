@@ -0,0 +1,291 @@
+#include "ResultWriter.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+void ResultWriter::writeSequence(std::ostream& out, const std::vector<int>& vertices) {
+    for (size_t i = 0; i < vertices.size(); i++) {
+        out << vertices[i];
+        if (i < vertices.size() - 1) out << "->";
+    }
+}
+
+void ResultWriter::writeText(std::ostream& out, const AlgorithmResult& result) {
+    const std::vector<int>& vertices = result.vertices;
+    
+    switch (result.kind) {
+        case ResultKind::EULER_CIRCUIT:
+            out << (result.found ? "YES" : "NO");
+            if (result.found && !vertices.empty() && vertices.size() <= EULER_PRINT_LIMIT) {
+                out << " - Circuit: ";
+                writeSequence(out, vertices);
+            }
+            break;
+            
+        case ResultKind::HAMILTON_CIRCUIT:
+            if (!result.exact) {
+                out << "UNKNOWN - Longest path found: " << vertices.size() << " of " << result.upperBound << " vertices";
+                if (!vertices.empty() && vertices.size() <= LIST_PRINT_LIMIT) {
+                    out << " (";
+                    writeSequence(out, vertices);
+                    out << ")";
+                }
+            } else if (!result.found) {
+                out << "NO";
+            } else if (vertices.empty()) {
+                out << "YES (trivial case)";
+            } else if (vertices.size() - 1 <= LIST_PRINT_LIMIT) {
+                out << "YES - Circuit: ";
+                writeSequence(out, vertices);
+            } else {
+                out << "YES - Circuit found (length: " << vertices.size() - 1 << ")";
+            }
+            break;
+            
+        case ResultKind::CLIQUE:
+            out << "Size: " << vertices.size();
+            if (!result.exact) {
+                out << " (upper bound " << result.upperBound << ")";
+            }
+            if (!vertices.empty() && vertices.size() <= LIST_PRINT_LIMIT) {
+                out << " - Vertices: {";
+                for (size_t i = 0; i < vertices.size(); i++) {
+                    out << vertices[i];
+                    if (i < vertices.size() - 1) out << ",";
+                }
+                out << "}";
+            }
+            break;
+            
+        case ResultKind::SPANNING_TREE:
+            if (result.edges.empty()) {
+                out << "Weight: 0 (trivial case)";
+                break;
+            }
+            out << "Weight: " << result.weight << " (Edges: " << result.edges.size();
+            if (result.trees > 1) {
+                out << ", Trees: " << result.trees;
+            }
+            out << ")";
+            if (result.edges.size() <= LIST_PRINT_LIMIT) {
+                out << " - MST edges: ";
+                for (size_t i = 0; i < result.edges.size(); i++) {
+                    out << result.edges[i].first << "-" << result.edges[i].second;
+                    if (i < result.edges.size() - 1) out << ",";
+                }
+            }
+            break;
+            
+        case ResultKind::STRONG_COMPONENTS:
+        case ResultKind::COMPONENTS: {
+            std::vector<std::vector<int>> members(result.trees);
+            size_t largest = 0;
+            for (size_t v = 0; v < vertices.size(); v++) {
+                members[vertices[v]].push_back(static_cast<int>(v));
+                largest = std::max(largest, members[vertices[v]].size());
+            }
+            out << "Components: " << result.trees << " (largest: " << largest << " vertices)";
+            if (!vertices.empty() && vertices.size() <= EULER_PRINT_LIMIT) {
+                out << " - ";
+                for (size_t c = 0; c < members.size(); c++) {
+                    out << "{";
+                    for (size_t i = 0; i < members[c].size(); i++) {
+                        out << members[c][i];
+                        if (i < members[c].size() - 1) out << ",";
+                    }
+                    out << "}";
+                    if (c < members.size() - 1) out << " ";
+                }
+            }
+            break;
+        }
+            
+        case ResultKind::TRIANGLES: {
+            double total = 0;
+            for (double value : result.values) total += value;
+            std::ostringstream average;
+            average << std::fixed << std::setprecision(4)
+                    << (result.values.empty() ? 0.0 : total / result.values.size());
+            out << "Triangles: " << result.weight << " - Average clustering: " << average.str();
+            break;
+        }
+            
+        case ResultKind::CORES: {
+            int inTopCore = 0;
+            for (int core : vertices) {
+                if (core == result.weight) inTopCore++;
+            }
+            out << "Degeneracy: " << result.weight << " (" << inTopCore << " vertices in the "
+                << result.weight << "-core)";
+            if (!vertices.empty() && vertices.size() <= EULER_PRINT_LIMIT) {
+                out << " - Core numbers: {";
+                for (size_t v = 0; v < vertices.size(); v++) {
+                    out << vertices[v];
+                    if (v < vertices.size() - 1) out << ",";
+                }
+                out << "}";
+            }
+            break;
+        }
+            
+        case ResultKind::DIAMETER:
+            out << "Diameter: " << result.weight;
+            if (!result.exact) {
+                out << " (upper bound " << result.upperBound << ")";
+            }
+            if (vertices.size() == 2) {
+                out << " - Between " << vertices[0] << " and " << vertices[1];
+            }
+            if (!result.values.empty() && result.values.size() <= EULER_PRINT_LIMIT) {
+                out << " - Eccentricities: {";
+                for (size_t v = 0; v < result.values.size(); v++) {
+                    out << static_cast<long long>(result.values[v]);
+                    if (v < result.values.size() - 1) out << ",";
+                }
+                out << "}";
+            }
+            break;
+
+        case ResultKind::PAGERANK: {
+            if (result.exact) {
+                out << "PageRank: converged in " << result.weight << " iterations";
+            } else {
+                out << "PageRank: " << result.weight << " iterations, not converged";
+            }
+            if (result.values.empty()) break;
+            size_t top = std::max_element(result.values.begin(), result.values.end()) - result.values.begin();
+            std::ostringstream scores;
+            scores << std::fixed << std::setprecision(4);
+            scores << " - Top: " << top << " (" << result.values[top] << ")";
+            if (result.values.size() <= EULER_PRINT_LIMIT) {
+                scores << " - Scores: {";
+                for (size_t v = 0; v < result.values.size(); v++) {
+                    scores << result.values[v];
+                    if (v < result.values.size() - 1) scores << ",";
+                }
+                scores << "}";
+            }
+            out << scores.str();
+            break;
+        }
+
+        case ResultKind::NONE:
+            break;
+    }
+}
+
+std::string ResultWriter::toText(const AlgorithmResult& result) {
+    std::ostringstream out;
+    writeText(out, result);
+    return out.str();
+}
+
+void ResultWriter::writeStatusText(std::ostream& out, const AlgorithmResult& result) {
+    if (!result.success) {
+        out << (result.interrupted ? "TIMEOUT - " : "ERROR - ") << result.error
+            << " (" << result.executionTime << "us)";
+        return;
+    }
+    if (!result.exact) out << "PARTIAL - ";
+    writeText(out, result);
+    out << " (" << result.executionTime << "us)";
+    if (!result.exact) out << " [" << result.error << "]";
+}
+
+void ResultWriter::writeVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+void ResultWriter::writeString(std::string& out, const std::string& value) {
+    writeVarint(out, value.size());
+    out += value;
+}
+
+void ResultWriter::writeDouble(std::string& out, double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (int shift = 56; shift >= 0; shift -= 8) {
+        out.push_back(static_cast<char>((bits >> shift) & 0xFF));
+    }
+}
+
+void ResultWriter::writeBinary(std::string& out, const AlgorithmResult& result) {
+    uint8_t flags = 0;
+    if (result.success) flags |= FLAG_SUCCESS;
+    if (result.exact) flags |= FLAG_EXACT;
+    if (result.interrupted) flags |= FLAG_INTERRUPTED;
+    if (result.found) flags |= FLAG_FOUND;
+    
+    out.push_back(static_cast<char>(result.kind));
+    out.push_back(static_cast<char>(flags));
+    writeVarint(out, result.executionTime > 0 ? result.executionTime : 0);
+    
+    if (result.success) {
+        writeVarint(out, result.vertices.size());
+        for (int v : result.vertices) {
+            writeVarint(out, v);
+        }
+        writeVarint(out, result.weight > 0 ? result.weight : 0);
+        writeVarint(out, result.edges.size());
+        for (const auto& edge : result.edges) {
+            writeVarint(out, edge.first);
+            writeVarint(out, edge.second);
+        }
+        writeVarint(out, result.trees);
+        if (!result.exact) {
+            writeVarint(out, result.upperBound);
+        }
+        writeVarint(out, result.values.size());
+        for (double value : result.values) {
+            writeDouble(out, value);
+        }
+    }
+    writeString(out, result.error);
+}
+
+void ResultWriter::writeBinaryHeader(std::string& out, int vertices, int edges, int count) {
+    out.push_back('G');
+    out.push_back('R');
+    out.push_back(static_cast<char>(BINARY_VERSION));
+    out.push_back('R');
+    writeVarint(out, vertices);
+    writeVarint(out, edges);
+    writeVarint(out, count);
+}
+
+void ResultWriter::writeBinaryEnd(std::string& out, long totalTime) {
+    writeVarint(out, totalTime > 0 ? totalTime : 0);
+}
+
+std::string ResultWriter::binaryError(const std::string& message) {
+    std::string body = {'G', 'R', static_cast<char>(BINARY_VERSION), 'E'};
+    writeString(body, message);
+    return frame(body);
+}
+
+std::string ResultWriter::frame(const std::string& body) {
+    uint32_t length = static_cast<uint32_t>(body.size());
+    std::string framed;
+    framed.reserve(body.size() + 4);
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        framed.push_back(static_cast<char>((length >> shift) & 0xFF));
+    }
+    framed += body;
+    return framed;
+}
+
+bool ResultWriter::parseFormatCommand(const std::string& input, ResponseFormat& format) {
+    if (input == "format text") {
+        format = ResponseFormat::TEXT;
+        return true;
+    }
+    if (input == "format binary") {
+        format = ResponseFormat::BINARY;
+        return true;
+    }
+    return false;
+}
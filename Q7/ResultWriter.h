@@ -0,0 +1,70 @@
+#ifndef RESULT_WRITER_H
+#define RESULT_WRITER_H
+
+#include "BaseAlgorithm.h"
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+enum class ResponseFormat { TEXT, BINARY };
+
+// The one place typed algorithm results become bytes for a client.
+//
+// Text is the human-readable answer the servers have always printed
+// ("YES - Circuit: 0->1->2->0", "Size: 3 - Vertices: {0,1,2}", ...).
+//
+// Binary is meant for programs. Integers are unsigned LEB128 varints and
+// strings are a varint length followed by the bytes. One result is
+//   kind (1 byte), flags (1 byte: success, exact, interrupted, found),
+//   executionTime,
+//   if success: vertex count and vertices, weight, edge count and edge
+//               endpoint pairs, trees, upperBound when not exact, and the
+//               value count followed by the values, each an IEEE 754
+//               double in 8 big-endian bytes,
+//   error string (empty when exact and successful).
+// A response is framed as a 4-byte big-endian body length, then the body:
+//   'G' 'R' version, message type ('R' results, 'E' error), and for results
+//   vertex and edge counts of the graph, result count, the results and the
+//   total time; for an error, the message string.
+class ResultWriter {
+public:
+    static constexpr uint8_t BINARY_VERSION = 3;
+    static constexpr uint8_t FLAG_SUCCESS = 1;
+    static constexpr uint8_t FLAG_EXACT = 2;
+    static constexpr uint8_t FLAG_INTERRUPTED = 4;
+    static constexpr uint8_t FLAG_FOUND = 8;
+
+    // The answer of a successful result, without status or timing
+    static void writeText(std::ostream& out, const AlgorithmResult& result);
+    static std::string toText(const AlgorithmResult& result);
+    // One result of a text response: the answer, or PARTIAL/TIMEOUT/ERROR
+    // and the reason, with the execution time
+    static void writeStatusText(std::ostream& out, const AlgorithmResult& result);
+
+    static void writeBinary(std::string& out, const AlgorithmResult& result);
+
+    // Header of a results body; follow it with `count` results and writeBinaryEnd()
+    static void writeBinaryHeader(std::string& out, int vertices, int edges, int count);
+    static void writeBinaryEnd(std::string& out, long totalTime);
+    static std::string binaryError(const std::string& message);
+
+    // Prefixes body with its length
+    static std::string frame(const std::string& body);
+
+    static void writeVarint(std::string& out, uint64_t value);
+    static void writeString(std::string& out, const std::string& value);
+    static void writeDouble(std::string& out, double value);
+
+    // Parses "format text" / "format binary" commands; false if input is not one
+    static bool parseFormatCommand(const std::string& input, ResponseFormat& format);
+
+private:
+    // Longest sequences still printed in full in text
+    static constexpr size_t EULER_PRINT_LIMIT = 15;
+    static constexpr size_t LIST_PRINT_LIMIT = 8;
+
+    static void writeSequence(std::ostream& out, const std::vector<int>& vertices);
+};
+
+#endif
@@ -0,0 +1,170 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+// Index of the pool worker running on this thread, or -1 for outside threads
+thread_local int currentWorker = -1;
+thread_local const ThreadPool* currentPool = nullptr;
+}
+
+ThreadPool::ThreadPool(unsigned int threadCount)
+    : stopping(false), pendingTasks(0), nextQueue(0) {
+    threadCount = std::max(1u, threadCount);
+    for (unsigned int i = 0; i < threadCount; i++) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (unsigned int i = 0; i < threadCount; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, static_cast<int>(i));
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    sleepCondition.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    // Workers keep their own subtasks local; outside callers spread round-robin
+    int target;
+    if (currentPool == this && currentWorker >= 0) {
+        target = currentWorker;
+    } else {
+        target = static_cast<int>(nextQueue.fetch_add(1) % queues.size());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queues[target]->mutex);
+        queues[target]->tasks.push_back(std::move(task));
+    }
+    pendingTasks.fetch_add(1);
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    sleepCondition.notify_one();
+}
+
+bool ThreadPool::popTask(int preferredQueue, std::function<void()>& task) {
+    int count = static_cast<int>(queues.size());
+
+    // Own queue: newest first
+    if (preferredQueue >= 0) {
+        WorkerQueue& own = *queues[preferredQueue];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    // Steal: oldest task of the first non-empty victim
+    int start = preferredQueue >= 0 ? preferredQueue + 1 : static_cast<int>(nextQueue.load() % count);
+    for (int i = 0; i < count; i++) {
+        WorkerQueue& victim = *queues[(start + i) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(int workerIndex) {
+    currentWorker = workerIndex;
+    currentPool = this;
+
+    while (true) {
+        std::function<void()> task;
+        if (popTask(workerIndex, task)) {
+            pendingTasks.fetch_sub(1);
+            try {
+                task();
+            } catch (const std::exception& e) {
+                std::cerr << "[ThreadPool] Task error: " << e.what() << std::endl;
+            } catch (...) {
+                std::cerr << "[ThreadPool] Unknown task error" << std::endl;
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepCondition.wait(lock, [this] {
+            return stopping.load() || pendingTasks.load() > 0;
+        });
+        if (stopping.load() && pendingTasks.load() == 0) break;
+    }
+}
+
+void TaskGroup::run(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->tasks.push_back(std::move(task));
+        state->pending++;
+    }
+    std::shared_ptr<State> shared = state;
+    pool.submit([shared]() { runNext(*shared); });
+}
+
+bool TaskGroup::runNext(State& state) {
+    std::function<void()> task;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (state.tasks.empty()) return false;
+        task = std::move(state.tasks.front());
+        state.tasks.pop_front();
+    }
+
+    std::exception_ptr thrown;
+    try {
+        task();
+    } catch (...) {
+        // Skipped work must not pass for a finished batch
+        thrown = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (thrown && !state.error) {
+        state.error = thrown;
+    }
+    if (--state.pending == 0) {
+        state.done.notify_all();
+    }
+    return true;
+}
+
+void TaskGroup::wait() {
+    join();
+    std::exception_ptr thrown;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        thrown.swap(state->error);
+    }
+    if (thrown) {
+        std::rethrow_exception(thrown);
+    }
+}
+
+void TaskGroup::join() {
+    while (runNext(*state)) {
+    }
+    // Whatever is left runs on other threads, which need nothing from this one
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [this] { return state->pending == 0; });
+}
@@ -0,0 +1,90 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool. Every worker owns a deque: it pops its own newest
+// task first (good locality for nested work) and steals the oldest task of
+// another worker when idle. Threads that wait on a TaskGroup run that group's
+// own tasks instead of blocking, so tasks may safely wait on nested groups.
+class ThreadPool {
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<bool> stopping;
+    std::atomic<int> pendingTasks;
+    std::atomic<unsigned int> nextQueue;
+
+    std::mutex sleepMutex;
+    std::condition_variable sleepCondition;
+
+    void workerLoop(int workerIndex);
+    bool popTask(int preferredQueue, std::function<void()>& task);
+
+public:
+    explicit ThreadPool(unsigned int threadCount = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+
+    int size() const { return static_cast<int>(workers.size()); }
+
+    // Process-wide pool sized to the machine, shared by all algorithms
+    static ThreadPool& shared();
+};
+
+// Tracks a batch of tasks submitted to a pool so the caller can join them.
+// The tasks wait in the group's own queue; the pool gets one entry per task
+// that runs the group's next one. A waiting thread therefore only ever helps
+// with its own group, never with another request's long-running work.
+// The first exception a task throws is kept and rethrown by wait(); the
+// other tasks still run to completion.
+class TaskGroup {
+private:
+    // Shared with the pool entries, which may outlive the group once its
+    // waiter has run all the tasks
+    struct State {
+        std::mutex mutex;
+        std::condition_variable done;
+        std::deque<std::function<void()>> tasks;
+        int pending = 0;            // Queued or running
+        std::exception_ptr error;   // First exception a task threw
+    };
+
+    ThreadPool& pool;
+    std::shared_ptr<State> state;
+
+    // Runs the oldest queued task of the group; false if none was queued
+    static bool runNext(State& state);
+    void join();
+
+public:
+    explicit TaskGroup(ThreadPool& threadPool) : pool(threadPool), state(std::make_shared<State>()) {}
+    // Joins without rethrowing; call wait() to see task errors
+    ~TaskGroup() { join(); }
+
+    void run(std::function<void()> task);
+
+    // Runs the group's queued tasks on the calling thread, then blocks until
+    // the ones other threads took have finished; rethrows the first
+    // exception a task threw
+    void wait();
+};
+
+#endif
@@ -0,0 +1,128 @@
+#include "afforest_components.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <unordered_map>
+
+void AfforestComponents::run(const AdjacencyArray& adjacency, bool directed, std::vector<int>& rootOf) {
+    int n = static_cast<int>(adjacency.offsets.size()) - 1;
+    std::vector<std::atomic<int>> parent(n);
+    for (int v = 0; v < n; v++) {
+        parent[v].store(v, std::memory_order_relaxed);
+    }
+
+    // Chunk boundaries by adjacency entries, each vertex counting as one
+    // more, so the passes that only touch vertices stay balanced too
+    std::vector<int> bounds{0};
+    size_t entriesInChunk = 0;
+    for (int v = 0; v < n; v++) {
+        entriesInChunk += adjacency.degree(v) + 1;
+        if (entriesInChunk >= CHUNK_EDGES) {
+            bounds.push_back(v + 1);
+            entriesInChunk = 0;
+        }
+    }
+    if (bounds.back() != n) bounds.push_back(n);
+    int chunks = static_cast<int>(bounds.size()) - 1;
+
+    ThreadPool& pool = ThreadPool::shared();
+    bool parallel = chunks > 1 && adjacency.targets.size() >= PARALLEL_MIN_EDGES && pool.size() > 1;
+    auto forEachChunk = [&](const std::function<void(int, int)>& body) {
+        if (parallel) {
+            TaskGroup group(pool);
+            for (int chunk = 0; chunk < chunks; chunk++) {
+                group.run([&body, &bounds, chunk]() { body(bounds[chunk], bounds[chunk + 1]); });
+            }
+            group.wait();
+        } else {
+            for (int chunk = 0; chunk < chunks; chunk++) {
+                body(bounds[chunk], bounds[chunk + 1]);
+            }
+        }
+    };
+    auto compressAll = [&parent](int first, int last) { compress(parent, first, last); };
+
+    // Sampling: the first few neighbors of every vertex
+    for (int round = 0; round < NEIGHBOR_ROUNDS; round++) {
+        forEachChunk([&](int first, int last) {
+            for (int v = first; v < last; v++) {
+                if (round < adjacency.degree(v)) {
+                    link(parent, v, adjacency.begin(v)[round]);
+                }
+            }
+        });
+        forEachChunk(compressAll);
+    }
+
+    // Finish: every other edge, except those of the largest component so far.
+    // Skipping is only sound when both directions of an edge are listed.
+    int largest = directed ? -1 : sampleFrequentRoot(parent);
+    forEachChunk([&](int first, int last) {
+        for (int v = first; v < last; v++) {
+            if (parent[v].load(std::memory_order_relaxed) == largest) continue;
+            for (const int* u = adjacency.begin(v) + NEIGHBOR_ROUNDS; u < adjacency.end(v); ++u) {
+                link(parent, v, *u);
+            }
+        }
+    });
+    forEachChunk(compressAll);
+
+    rootOf.resize(n);
+    for (int v = 0; v < n; v++) {
+        rootOf[v] = parent[v].load(std::memory_order_relaxed);
+    }
+}
+
+// Walks both vertices up to their roots and hooks the larger root under the
+// smaller. A failed compare-and-swap means another thread hooked that root
+// first; the walk then continues from where it now points.
+bool AfforestComponents::link(std::vector<std::atomic<int>>& parent, int u, int v) {
+    int p1 = parent[u].load(std::memory_order_relaxed);
+    int p2 = parent[v].load(std::memory_order_relaxed);
+    while (p1 != p2) {
+        int high = std::max(p1, p2);
+        int low = std::min(p1, p2);
+        int highParent = parent[high].load(std::memory_order_relaxed);
+        if (highParent == low) return false;
+        if (highParent == high &&
+            parent[high].compare_exchange_strong(highParent, low, std::memory_order_relaxed)) {
+            return true;
+        }
+        p1 = parent[parent[high].load(std::memory_order_relaxed)].load(std::memory_order_relaxed);
+        p2 = parent[low].load(std::memory_order_relaxed);
+    }
+    return false;
+}
+
+void AfforestComponents::compress(std::vector<std::atomic<int>>& parent, int first, int last) {
+    for (int v = first; v < last; v++) {
+        int p = parent[v].load(std::memory_order_relaxed);
+        int grandparent = parent[p].load(std::memory_order_relaxed);
+        while (p != grandparent) {
+            parent[v].store(grandparent, std::memory_order_relaxed);
+            p = grandparent;
+            grandparent = parent[p].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// Most common root among a fixed pseudo-random sample of vertices
+int AfforestComponents::sampleFrequentRoot(const std::vector<std::atomic<int>>& parent) {
+    int n = static_cast<int>(parent.size());
+    if (n == 0) return -1;
+    std::mt19937 rng(27491095);
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    std::unordered_map<int, int> seen;
+    int best = -1;
+    int bestCount = 0;
+    for (int i = 0; i < SAMPLE_COUNT; i++) {
+        int root = parent[pick(rng)].load(std::memory_order_relaxed);
+        int count = ++seen[root];
+        if (count > bestCount) {
+            best = root;
+            bestCount = count;
+        }
+    }
+    return best;
+}
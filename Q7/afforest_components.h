@@ -0,0 +1,47 @@
+#ifndef AFFOREST_COMPONENTS_H
+#define AFFOREST_COMPONENTS_H
+
+#include "GraphAnalysisContext.h"
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Connected components by Afforest (Sutton, Ben-Nun and Barak) over a
+// lock-free union-find.
+//
+// Every vertex starts as its own tree, and linking two trees hooks the larger
+// root under the smaller one with a compare-and-swap, so a parent is never
+// larger than its child and each root ends up the smallest vertex of its
+// component. Afforest first links only the first NEIGHBOR_ROUNDS neighbors
+// of every vertex, which on real graphs already joins most of the largest
+// component, then finds that component by sampling and skips its vertices
+// when linking the remaining edges: the edges they share with the rest of
+// the graph are seen from the other side.
+//
+// Each pass over the vertices runs in chunks of about CHUNK_EDGES adjacency
+// entries on the shared work-stealing pool once there are PARALLEL_MIN_EDGES
+// of them; smaller graphs take the same passes on the calling thread.
+class AfforestComponents {
+public:
+    static constexpr int NEIGHBOR_ROUNDS = 2;
+    static constexpr int SAMPLE_COUNT = 1024;
+    static constexpr size_t CHUNK_EDGES = 16384;
+    static constexpr size_t PARALLEL_MIN_EDGES = 65536;
+
+    // Fills rootOf[v] with the smallest vertex of v's component. For a
+    // directed graph, adjacency holds out-neighbors and the components are
+    // the weak ones.
+    static void run(const AdjacencyArray& adjacency, bool directed, std::vector<int>& rootOf);
+
+    // Joins the trees of u and v, safe against concurrent calls on the same
+    // parent array. True only for the one call that joined two different
+    // trees, so the pairs it accepted form a spanning forest.
+    static bool link(std::vector<std::atomic<int>>& parent, int u, int v);
+
+private:
+    // Points every vertex of [first, last) straight at its root
+    static void compress(std::vector<std::atomic<int>>& parent, int first, int last);
+    static int sampleFrequentRoot(const std::vector<std::atomic<int>>& parent);
+};
+
+#endif
@@ -0,0 +1,105 @@
+#include "boruvka_mst.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <numeric>
+
+// Weight in the high word, flipped so signed order becomes unsigned order;
+// the edge index breaks ties
+uint64_t BoruvkaMST::edgeKey(const Edge& edge, uint32_t index) {
+    uint32_t weight = static_cast<uint32_t>(edge.weight) ^ 0x80000000u;
+    return (static_cast<uint64_t>(weight) << 32) | index;
+}
+
+void BoruvkaMST::offerMinimum(std::atomic<uint64_t>& slot, uint64_t key) {
+    uint64_t current = slot.load(std::memory_order_relaxed);
+    while (key < current && !slot.compare_exchange_weak(current, key, std::memory_order_relaxed)) {
+    }
+}
+
+bool BoruvkaMST::run(int vertexCount, const std::vector<Edge>& edges, std::vector<Edge>& forest,
+                     ExecutionContext& context) {
+    int n = vertexCount;
+    std::vector<int> label(n);
+    std::iota(label.begin(), label.end(), 0);
+    std::vector<int> parent(label);
+    std::unique_ptr<std::atomic<uint64_t>[]> lightest(new std::atomic<uint64_t>[n]);
+    for (int v = 0; v < n; v++) {
+        lightest[v].store(NO_EDGE, std::memory_order_relaxed);
+    }
+
+    // Indices of edges whose endpoints are still in different components
+    std::vector<uint32_t> active(edges.size());
+    std::iota(active.begin(), active.end(), 0u);
+
+    auto find = [&parent](int x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    };
+
+    ThreadPool& pool = ThreadPool::shared();
+    bool parallel = pool.size() > 1;
+
+    while (!active.empty()) {
+        size_t chunks = (active.size() + CHUNK_EDGES - 1) / CHUNK_EDGES;
+        std::vector<std::vector<uint32_t>> kept(chunks);
+
+        // Drop internal edges and offer the rest to both components
+        auto scanChunk = [&](size_t chunk) {
+            if (context.charge(CHUNK_EDGES)) return;
+            size_t begin = chunk * CHUNK_EDGES;
+            size_t end = std::min(active.size(), begin + CHUNK_EDGES);
+            std::vector<uint32_t>& survivors = kept[chunk];
+            survivors.reserve(end - begin);
+            for (size_t i = begin; i < end; i++) {
+                uint32_t index = active[i];
+                const Edge& edge = edges[index];
+                int a = label[edge.u], b = label[edge.v];
+                if (a == b) continue;
+                survivors.push_back(index);
+                uint64_t key = edgeKey(edge, index);
+                offerMinimum(lightest[a], key);
+                offerMinimum(lightest[b], key);
+            }
+        };
+        if (parallel && chunks > 1) {
+            TaskGroup group(pool);
+            for (size_t chunk = 0; chunk < chunks; chunk++) {
+                group.run([&scanChunk, chunk]() { scanChunk(chunk); });
+            }
+            group.wait();
+        } else {
+            for (size_t chunk = 0; chunk < chunks && !context.isStopped(); chunk++) {
+                scanChunk(chunk);
+            }
+        }
+        if (context.isStopped()) return false;
+
+        active.clear();
+        for (auto& survivors : kept) {
+            active.insert(active.end(), survivors.begin(), survivors.end());
+        }
+        if (active.empty()) break;
+
+        // Merge along every component's lightest edge; distinct keys rule out
+        // cycles, the find check only skips an edge picked from both sides
+        for (int c = 0; c < n; c++) {
+            uint64_t key = lightest[c].load(std::memory_order_relaxed);
+            if (key == NO_EDGE) continue;
+            lightest[c].store(NO_EDGE, std::memory_order_relaxed);
+            const Edge& edge = edges[static_cast<uint32_t>(key)];
+            int a = find(edge.u), b = find(edge.v);
+            if (a == b) continue;
+            parent[std::max(a, b)] = std::min(a, b);
+            forest.push_back(edge);
+        }
+        for (int v = 0; v < n; v++) {
+            label[v] = find(v);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,35 @@
+#ifndef BORUVKA_MST_H
+#define BORUVKA_MST_H
+
+#include "Mst_algorithm.h"
+#include "ExecutionContext.h"
+#include <cstdint>
+#include <vector>
+
+// Parallel Borůvka for large edge sets. Every round each component picks its
+// lightest outgoing edge (ties broken by edge index, so the choice is a total
+// order and the picked edges never close a cycle), the picked edges are
+// merged, and edges that became internal are dropped. At least half of the
+// components disappear per round, so there are O(log V) rounds.
+//
+// The per-edge work of a round runs in chunks on the shared thread pool:
+// components are read from a flat label array that is only rewritten between
+// rounds, and each component's lightest edge is kept in an atomic word
+// updated with a compare-and-swap minimum. Merging touches one edge per
+// component and stays sequential. Disconnected input yields a spanning forest.
+class BoruvkaMST {
+public:
+    static constexpr size_t CHUNK_EDGES = 16384;
+
+    // Appends the forest's edges to forest; false if the context stopped it
+    static bool run(int vertexCount, const std::vector<Edge>& edges, std::vector<Edge>& forest,
+                    ExecutionContext& context);
+
+private:
+    static constexpr uint64_t NO_EDGE = ~0ULL;
+
+    static uint64_t edgeKey(const Edge& edge, uint32_t index);
+    static void offerMinimum(std::atomic<uint64_t>& slot, uint64_t key);
+};
+
+#endif
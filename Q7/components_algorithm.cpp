@@ -0,0 +1,29 @@
+#include "components_algorithm.h"
+#include <chrono>
+
+AlgorithmResult ConnectedComponentsAlgorithm::execute(GraphAnalysisContext& analysis, ExecutionContext& context) {
+    auto start = std::chrono::high_resolution_clock::now();
+    AlgorithmResult result;
+    
+    try {
+        if (context.check()) {
+            result.markInterrupted(context);
+            return result;
+        }
+        
+        const ComponentInfo& components = analysis.components();
+        result.kind = ResultKind::COMPONENTS;
+        result.vertices = components.componentOf;
+        result.trees = components.count;
+        result.success = true;
+        
+    } catch (const std::exception& e) {
+        result.success = false;
+        result.error = e.what();
+    }
+    
+    auto end = std::chrono::high_resolution_clock::now();
+    result.executionTime = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    
+    return result;
+}
@@ -0,0 +1,17 @@
+#ifndef COMPONENTS_ALGORITHM_H
+#define COMPONENTS_ALGORITHM_H
+
+#include "BaseAlgorithm.h"
+
+// Connected components (weak ones for a directed graph) by parallel Afforest
+// union-find (see AfforestComponents), O(V + E) work.
+class ConnectedComponentsAlgorithm : public BaseAlgorithm {
+public:
+    using BaseAlgorithm::execute;
+    AlgorithmResult execute(GraphAnalysisContext& analysis, ExecutionContext& context) override;
+    std::string getName() const override { return "Connected Components"; }
+    bool supportsDirected() const override { return true; }
+    bool supportsUndirected() const override { return true; }
+};
+
+#endif
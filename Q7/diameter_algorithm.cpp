@@ -0,0 +1,338 @@
+#include "diameter_algorithm.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+
+AlgorithmResult DiameterAlgorithm::execute(GraphAnalysisContext& analysis, ExecutionContext& context) {
+    const Graph& graph = analysis.getGraph();
+    auto start = std::chrono::high_resolution_clock::now();
+    AlgorithmResult result;
+
+    try {
+        if (graph.isDirected()) {
+            result.success = false;
+            result.error = "Diameter works only on undirected graphs";
+            return result;
+        }
+
+        if (context.check()) {
+            result.markInterrupted(context);
+            return result;
+        }
+
+        const AdjacencyArray& adjacency = analysis.adjacency();
+        const ComponentInfo& components = analysis.components();
+        int n = graph.getVertexCount();
+        bool allSources = n <= ALL_SOURCES_MAX_VERTICES;
+
+        // Vertices grouped by component, largest component first; a
+        // component of s vertices has diameter at most s - 1
+        std::vector<int> memberOffsets(components.count + 1, 0);
+        for (int c = 0; c < components.count; c++) {
+            memberOffsets[c + 1] = memberOffsets[c] + components.sizes[c];
+        }
+        std::vector<int> members(n);
+        std::vector<int> fill(memberOffsets.begin(), memberOffsets.end() - 1);
+        for (int v = 0; v < n; v++) {
+            members[fill[components.componentOf[v]]++] = v;
+        }
+        std::vector<int> order(components.count);
+        for (int c = 0; c < components.count; c++) {
+            order[c] = c;
+        }
+        std::stable_sort(order.begin(), order.end(), [&components](int a, int b) {
+            return components.sizes[a] > components.sizes[b];
+        });
+
+        std::vector<std::atomic<int>> reached(n);
+        for (int v = 0; v < n; v++) {
+            reached[v].store(0, std::memory_order_relaxed);
+        }
+        std::vector<int> distanceFromU(allSources ? 0 : n, -1);
+        std::vector<int> distanceFromA(allSources ? 0 : n, -1);
+        std::vector<int> distanceFromB(allSources ? 0 : n, -1);
+        std::vector<Eccentricity> eccentricities;
+        WorkspacePool workspaces;
+
+        int best = 0;
+        std::pair<int, int> ends(-1, -1);
+        auto offer = [&best, &ends](int distance, int a, int b) {
+            if (distance > best) {
+                best = distance;
+                ends = {std::min(a, b), std::max(a, b)};
+            }
+        };
+
+        int upperBound = -1;  // Set only if the context stopped the search
+        for (size_t k = 0; k < order.size(); k++) {
+            int c = order[k];
+            const int* first = members.data() + memberOffsets[c];
+            int size = components.sizes[c];
+            std::vector<int> component(first, first + size);
+
+            if (allSources) {
+                // Every vertex a source: eccentricities are exact
+                if (!searchSources(adjacency, component, workspaces, eccentricities, reached, context)) {
+                    upperBound = std::max(best, size - 1);
+                    break;
+                }
+                for (int i = 0; i < size; i++) {
+                    offer(eccentricities[i].distance, component[i], eccentricities[i].farthest);
+                }
+                continue;
+            }
+
+            if (size - 1 <= best) break;
+
+            // Double sweep from the vertex of highest degree, then the middle
+            // of the path it found as the center for iFUB
+            int r = *std::max_element(component.begin(), component.end(), [&adjacency](int a, int b) {
+                return adjacency.degree(a) < adjacency.degree(b);
+            });
+            Eccentricity fromR, fromA, fromB, fromU;
+            if (!bfs(adjacency, r, distanceFromU, reached, fromR, context) ||
+                !bfs(adjacency, fromR.farthest, distanceFromA, reached, fromA, context) ||
+                !bfs(adjacency, fromA.farthest, distanceFromB, reached, fromB, context)) {
+                upperBound = std::max(best, size - 1);
+                break;
+            }
+            int a = fromR.farthest;
+            int b = fromA.farthest;
+            offer(fromA.distance, a, b);
+            int half = fromA.distance / 2;
+            int u = a;
+            for (int v : component) {
+                if (distanceFromA[v] == half && distanceFromB[v] == fromA.distance - half) {
+                    u = v;
+                    break;
+                }
+            }
+            for (int v : component) {
+                distanceFromU[v] = -1;
+            }
+            if (!bfs(adjacency, u, distanceFromU, reached, fromU, context)) {
+                upperBound = std::max(best, size - 1);
+                break;
+            }
+            offer(fromU.distance, u, fromU.farthest);
+            offer(fromB.distance, b, fromB.farthest);
+
+            // Fringes of u, outermost first. After fringe i, a vertex nearer
+            // to u than i has eccentricity at most 2(i - 1).
+            std::vector<int> fringeOffsets(fromU.distance + 2, 0);
+            for (int v : component) {
+                fringeOffsets[distanceFromU[v] + 1]++;
+            }
+            for (int i = 0; i <= fromU.distance; i++) {
+                fringeOffsets[i + 1] += fringeOffsets[i];
+            }
+            std::vector<int> byDistance(size);
+            std::vector<int> position(fringeOffsets.begin(), fringeOffsets.end() - 1);
+            for (int v : component) {
+                byDistance[position[distanceFromU[v]]++] = v;
+            }
+
+            int bound = std::min(2 * fromU.distance, size - 1);
+            for (int i = fromU.distance; i > 0 && bound > best; i--) {
+                std::vector<int> fringe(byDistance.begin() + fringeOffsets[i],
+                                        byDistance.begin() + fringeOffsets[i + 1]);
+                if (!searchSources(adjacency, fringe, workspaces, eccentricities, reached, context)) {
+                    // Components not searched yet are no larger than this one
+                    int nextSize = k + 1 < order.size() ? components.sizes[order[k + 1]] : 1;
+                    upperBound = std::max(bound, nextSize - 1);
+                    break;
+                }
+                for (size_t j = 0; j < fringe.size(); j++) {
+                    offer(eccentricities[j].distance, fringe[j], eccentricities[j].farthest);
+                }
+                if (best > 2 * (i - 1)) break;
+                bound = 2 * (i - 1);
+            }
+            if (upperBound >= 0) break;
+
+            for (int v : component) {
+                distanceFromU[v] = distanceFromA[v] = distanceFromB[v] = -1;
+            }
+        }
+
+        result.kind = ResultKind::DIAMETER;
+        result.weight = best;
+        if (ends.first >= 0) {
+            result.vertices = {ends.first, ends.second};
+        }
+        result.values.resize(n);
+        for (int v = 0; v < n; v++) {
+            result.values[v] = reached[v].load(std::memory_order_relaxed);
+        }
+        result.success = true;
+        if (upperBound >= 0) {
+            result.upperBound = std::max(upperBound, best);
+            result.interrupted = true;
+            result.markPartial(context.describeStop());
+        }
+
+    } catch (const std::exception& e) {
+        result.success = false;
+        result.error = e.what();
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    result.executionTime = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    return result;
+}
+
+void DiameterAlgorithm::raise(std::atomic<int>& slot, int value) {
+    int current = slot.load(std::memory_order_relaxed);
+    while (value > current && !slot.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+bool DiameterAlgorithm::bfs(const AdjacencyArray& adjacency, int source, std::vector<int>& distance,
+                            std::vector<std::atomic<int>>& reached, Eccentricity& eccentricity,
+                            ExecutionContext& context) {
+    std::vector<int> queue{source};
+    distance[source] = 0;
+    eccentricity = {0, source};
+    size_t levelEnd = queue.size();
+    long long scanned = 0;
+    for (size_t head = 0; head < queue.size(); head++) {
+        int v = queue[head];
+        for (const int* u = adjacency.begin(v); u != adjacency.end(v); ++u) {
+            if (distance[*u] < 0) {
+                distance[*u] = distance[v] + 1;
+                queue.push_back(*u);
+                raise(reached[*u], distance[*u]);
+                eccentricity = {distance[*u], *u};
+            }
+        }
+        scanned += adjacency.degree(v);
+        if (head + 1 == levelEnd) {
+            if (context.charge(scanned + static_cast<long long>(queue.size() - levelEnd))) {
+                return false;
+            }
+            scanned = 0;
+            levelEnd = queue.size();
+        }
+    }
+    raise(reached[source], eccentricity.distance);
+    return true;
+}
+
+bool DiameterAlgorithm::searchSources(const AdjacencyArray& adjacency, const std::vector<int>& sources,
+                                      WorkspacePool& workspaces, std::vector<Eccentricity>& eccentricities,
+                                      std::vector<std::atomic<int>>& reached, ExecutionContext& context) {
+    int n = static_cast<int>(adjacency.offsets.size()) - 1;
+    int count = static_cast<int>(sources.size());
+    int batches = (count + BATCH_SOURCES - 1) / BATCH_SOURCES;
+    eccentricities.assign(count, Eccentricity{0, -1});
+
+    auto runBatch = [&](int batch) {
+        if (context.isStopped()) return;
+        std::unique_ptr<Workspace> workspace;
+        {
+            std::lock_guard<std::mutex> lock(workspaces.mutex);
+            if (!workspaces.idle.empty()) {
+                workspace = std::move(workspaces.idle.back());
+                workspaces.idle.pop_back();
+            }
+        }
+        if (!workspace) {
+            workspace.reset(new Workspace());
+            workspace->seen.assign(n, 0);
+            workspace->visit.assign(n, 0);
+            workspace->next.assign(n, 0);
+        }
+        int firstSource = batch * BATCH_SOURCES;
+        searchBatch(adjacency, sources.data() + firstSource, std::min(BATCH_SOURCES, count - firstSource),
+                    *workspace, eccentricities.data() + firstSource, reached, context);
+        std::lock_guard<std::mutex> lock(workspaces.mutex);
+        workspaces.idle.push_back(std::move(workspace));
+    };
+
+    ThreadPool& pool = ThreadPool::shared();
+    if (batches > 1 && pool.size() > 1) {
+        TaskGroup group(pool);
+        for (int batch = 0; batch < batches; batch++) {
+            group.run([&runBatch, batch]() { runBatch(batch); });
+        }
+        group.wait();
+    } else {
+        for (int batch = 0; batch < batches; batch++) {
+            runBatch(batch);
+        }
+    }
+    return !context.isStopped();
+}
+
+// One BFS level for all sources at once: a vertex's visit word holds the
+// sources whose frontier it is on, and each edge passes on the ones the
+// neighbor has not seen yet
+bool DiameterAlgorithm::searchBatch(const AdjacencyArray& adjacency, const int* sources, int count,
+                                    Workspace& workspace, Eccentricity* eccentricities,
+                                    std::vector<std::atomic<int>>& reached, ExecutionContext& context) {
+    std::vector<uint64_t>& seen = workspace.seen;
+    std::vector<uint64_t>& visit = workspace.visit;
+    std::vector<uint64_t>& next = workspace.next;
+    std::vector<int>& frontier = workspace.frontier;
+    std::vector<int>& nextFrontier = workspace.nextFrontier;
+    // Every vertex reached, to clear the words again at the end
+    std::vector<int> touched;
+
+    frontier.clear();
+    for (int i = 0; i < count; i++) {
+        int s = sources[i];
+        if (!seen[s]) {
+            frontier.push_back(s);
+            touched.push_back(s);
+        }
+        seen[s] |= 1ULL << i;
+        visit[s] |= 1ULL << i;
+        eccentricities[i] = {0, s};
+    }
+
+    bool finished = true;
+    for (int level = 1; !frontier.empty(); level++) {
+        long long scanned = 0;
+        nextFrontier.clear();
+        for (int v : frontier) {
+            uint64_t bits = visit[v];
+            for (const int* u = adjacency.begin(v); u != adjacency.end(v); ++u) {
+                uint64_t fresh = bits & ~seen[*u];
+                if (fresh) {
+                    if (!next[*u]) nextFrontier.push_back(*u);
+                    next[*u] |= fresh;
+                }
+            }
+            scanned += adjacency.degree(v);
+        }
+        for (int v : frontier) {
+            visit[v] = 0;
+        }
+        for (int u : nextFrontier) {
+            uint64_t bits = next[u];
+            next[u] = 0;
+            if (!seen[u]) touched.push_back(u);
+            seen[u] |= bits;
+            visit[u] = bits;
+            raise(reached[u], level);
+            while (bits) {
+                eccentricities[__builtin_ctzll(bits)] = {level, u};
+                bits &= bits - 1;
+            }
+        }
+        frontier.swap(nextFrontier);
+        if (context.charge(scanned + static_cast<long long>(frontier.size()))) {
+            finished = false;
+            break;
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        raise(reached[sources[i]], eccentricities[i].distance);
+    }
+    for (int v : touched) {
+        seen[v] = visit[v] = next[v] = 0;
+    }
+    return finished;
+}
@@ -0,0 +1,83 @@
+#ifndef DIAMETER_ALGORITHM_H
+#define DIAMETER_ALGORITHM_H
+
+#include "BaseAlgorithm.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Diameter (the largest distance between two connected vertices) and
+// eccentricities of an undirected graph, by breadth-first search in hops.
+//
+// Searches from many sources share one multi-source BFS (MS-BFS): each
+// vertex holds one 64-bit word per search state, bit i standing for source
+// i, so a frontier step moves 64 searches with one AND-NOT and one OR per
+// edge. Batches of 64 sources run as tasks on the shared pool.
+//
+// Up to ALL_SOURCES_MAX_VERTICES every vertex is a source, so every
+// eccentricity is exact. Larger graphs use iFUB (Crescenzi et al.) on each
+// component: a double sweep picks a central vertex u, and the fringe sets
+// of u (vertices at distance i from u, from the outermost in) are searched
+// one after the other. Once the largest eccentricity found exceeds 2(i - 1),
+// no vertex nearer to u can do better, so a few fringes usually settle the
+// exact diameter. Eccentricities are then lower bounds: the largest distance
+// any of the searches measured, exact for the searched vertices.
+//
+// If the context stops the search, the result holds the largest distance
+// found so far with a proven upper bound, marked as not exact.
+class DiameterAlgorithm : public BaseAlgorithm {
+public:
+    static constexpr int BATCH_SOURCES = 64;
+    static constexpr int ALL_SOURCES_MAX_VERTICES = 4096;
+
+    using BaseAlgorithm::execute;
+    AlgorithmResult execute(GraphAnalysisContext& analysis, ExecutionContext& context) override;
+    std::string getName() const override { return "Diameter"; }
+    bool supportsDirected() const override { return false; }
+    bool supportsUndirected() const override { return true; }
+
+private:
+    // Search state of one MS-BFS batch over the whole vertex range. Only the
+    // vertices of the component searched are touched, and they are cleared
+    // again afterwards, so a workspace is reused across batches.
+    struct Workspace {
+        std::vector<uint64_t> seen;
+        std::vector<uint64_t> visit;
+        std::vector<uint64_t> next;
+        std::vector<int> frontier;
+        std::vector<int> nextFrontier;
+    };
+
+    // Workspaces not in use; there are at most as many as batches that ran
+    // at the same time
+    struct WorkspacePool {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Workspace>> idle;
+    };
+
+    // Largest distance found from a source, and a vertex at that distance
+    struct Eccentricity {
+        int distance;
+        int farthest;
+    };
+
+    // Eccentricities of sources (all in one component), in batches of
+    // BATCH_SOURCES on the shared pool; raises reached[v] to the largest
+    // distance any source has to v. False if the context stopped it.
+    static bool searchSources(const AdjacencyArray& adjacency, const std::vector<int>& sources,
+                              WorkspacePool& workspaces, std::vector<Eccentricity>& eccentricities,
+                              std::vector<std::atomic<int>>& reached, ExecutionContext& context);
+    static bool searchBatch(const AdjacencyArray& adjacency, const int* sources, int count,
+                            Workspace& workspace, Eccentricity* eccentricities,
+                            std::vector<std::atomic<int>>& reached, ExecutionContext& context);
+    // Single-source BFS filling distance (-1 outside the component), charged
+    // to the context a level at a time. False if the context stopped it.
+    static bool bfs(const AdjacencyArray& adjacency, int source, std::vector<int>& distance,
+                    std::vector<std::atomic<int>>& reached, Eccentricity& eccentricity,
+                    ExecutionContext& context);
+    static void raise(std::atomic<int>& slot, int value);
+};
+
+#endif
@@ -0,0 +1,185 @@
+#include "euler_tour.h"
+#include "afforest_components.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <stdexcept>
+
+bool ParallelEulerTour::run(const AdjacencyArray& adjacency, bool directed, std::vector<int>& circuit,
+                            ExecutionContext& context) {
+    int n = static_cast<int>(adjacency.offsets.size()) - 1;
+    int slots = static_cast<int>(adjacency.targets.size());
+    circuit.clear();
+    if (slots == 0) return true;
+
+    // Ends: undirected, an edge is listed at both endpoints and every list
+    // entry is an end. Directed, entry s is the out-end of edge s and the
+    // in-ends follow at slots + position in the transposed lists.
+    int ends = directed ? 2 * slots : slots;
+    int edgeCount = directed ? slots : slots / 2;
+    std::vector<int> at(ends);        // Vertex of an end
+    std::vector<int> twin(ends);      // Other end of the same edge
+    std::vector<int> partner(ends);   // End paired with it at its vertex
+    std::vector<int> inOffsets;
+
+    std::vector<int> bounds{0};
+    size_t entriesInChunk = 0;
+    for (int v = 0; v < n; v++) {
+        entriesInChunk += 2 * adjacency.degree(v) + 1;
+        if (entriesInChunk >= CHUNK_EDGES) {
+            bounds.push_back(v + 1);
+            entriesInChunk = 0;
+        }
+    }
+    if (bounds.back() != n) bounds.push_back(n);
+    int chunks = static_cast<int>(bounds.size()) - 1;
+
+    ThreadPool& pool = ThreadPool::shared();
+    bool parallel = chunks > 1 && pool.size() > 1;
+    auto forEachChunk = [&](const std::function<void(int, int)>& body) {
+        auto runChunk = [&](int chunk) {
+            int first = bounds[chunk], last = bounds[chunk + 1];
+            if (context.charge(adjacency.offsets[last] - adjacency.offsets[first])) return;
+            body(first, last);
+        };
+        if (parallel) {
+            TaskGroup group(pool);
+            for (int chunk = 0; chunk < chunks; chunk++) {
+                group.run([&runChunk, chunk]() { runChunk(chunk); });
+            }
+            group.wait();
+        } else {
+            for (int chunk = 0; chunk < chunks && !context.isStopped(); chunk++) {
+                runChunk(chunk);
+            }
+        }
+        return !context.isStopped();
+    };
+
+    // Ends and their pairing. Every list has even length, so consecutive
+    // entries of one vertex pair up.
+    if (!directed) {
+        bool finished = forEachChunk([&](int first, int last) {
+            for (int v = first; v < last; v++) {
+                for (int s = adjacency.offsets[v]; s < adjacency.offsets[v + 1]; s++) {
+                    int u = adjacency.targets[s];
+                    at[s] = v;
+                    twin[s] = static_cast<int>(std::lower_bound(adjacency.begin(u), adjacency.end(u), v) -
+                                               adjacency.targets.data());
+                    partner[s] = s ^ 1;
+                }
+            }
+        });
+        if (!finished) return false;
+    } else {
+        // Transposed lists of out-entries, each sorted by source; in-end k
+        // of v pairs with out-end k
+        std::vector<std::atomic<int>> cursor(n + 1);
+        for (int v = 0; v <= n; v++) {
+            cursor[v].store(0, std::memory_order_relaxed);
+        }
+        bool finished = forEachChunk([&](int first, int last) {
+            for (const int* u = adjacency.begin(first); u != adjacency.end(last - 1); ++u) {
+                cursor[*u + 1].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+        if (!finished) return false;
+        inOffsets.assign(n + 1, 0);
+        for (int v = 0; v < n; v++) {
+            inOffsets[v + 1] = inOffsets[v] + cursor[v + 1].load(std::memory_order_relaxed);
+            cursor[v].store(inOffsets[v], std::memory_order_relaxed);
+        }
+
+        std::vector<int> inEntries(slots);
+        finished = forEachChunk([&](int first, int last) {
+            for (int v = first; v < last; v++) {
+                for (int s = adjacency.offsets[v]; s < adjacency.offsets[v + 1]; s++) {
+                    inEntries[cursor[adjacency.targets[s]].fetch_add(1, std::memory_order_relaxed)] = s;
+                }
+            }
+        });
+        if (!finished) return false;
+        finished = forEachChunk([&](int first, int last) {
+            for (int v = first; v < last; v++) {
+                std::sort(inEntries.begin() + inOffsets[v], inEntries.begin() + inOffsets[v + 1]);
+                for (int k = 0; k < inOffsets[v + 1] - inOffsets[v]; k++) {
+                    int in = slots + inOffsets[v] + k;
+                    int out = adjacency.offsets[v] + k;
+                    int s = inEntries[inOffsets[v] + k];
+                    at[in] = v;
+                    at[out] = v;
+                    twin[in] = s;
+                    twin[s] = in;
+                    partner[in] = out;
+                    partner[out] = in;
+                }
+            }
+        });
+        if (!finished) return false;
+    }
+
+    // Trails: ends joined to their twin and their partner
+    AdjacencyArray transitions;
+    transitions.offsets.resize(ends + 1);
+    transitions.targets.resize(2 * static_cast<size_t>(ends));
+    for (int x = 0; x <= ends; x++) {
+        transitions.offsets[x] = 2 * x;
+    }
+    bool finished = forEachChunk([&](int first, int last) {
+        auto fill = [&](int x) {
+            transitions.targets[2 * x] = std::min(twin[x], partner[x]);
+            transitions.targets[2 * x + 1] = std::max(twin[x], partner[x]);
+        };
+        for (int x = adjacency.offsets[first]; x < adjacency.offsets[last]; x++) fill(x);
+        if (directed) {
+            for (int x = slots + inOffsets[first]; x < slots + inOffsets[last]; x++) fill(x);
+        }
+    });
+    if (!finished) return false;
+    std::vector<int> trail;
+    AfforestComponents::run(transitions, false, trail);
+    transitions = AdjacencyArray();
+
+    // Splice every vertex's pairs into the trail of its first pair, keeping
+    // only splices that join two trails not yet joined elsewhere
+    std::vector<std::atomic<int>> joined(ends);
+    for (int x = 0; x < ends; x++) {
+        joined[x].store(x, std::memory_order_relaxed);
+    }
+    finished = forEachChunk([&](int first, int last) {
+        for (int v = first; v < last; v++) {
+            int firstEnd = directed ? slots + inOffsets[v] : adjacency.offsets[v];
+            int step = directed ? 1 : 2;
+            int pairs = adjacency.degree(v) / step;
+            int a = firstEnd;
+            for (int k = 1; k < pairs; k++) {
+                int c = firstEnd + k * step;
+                if (!AfforestComponents::link(joined, trail[a], trail[c])) continue;
+                int b = partner[a], d = partner[c];
+                partner[a] = d;
+                partner[d] = a;
+                partner[c] = b;
+                partner[b] = c;
+            }
+        }
+    });
+    if (!finished) return false;
+
+    // One closed trail now; walk it from the smallest vertex with an edge
+    int start = 0;
+    while (adjacency.degree(start) == 0) start++;
+    int firstEnd = directed ? slots + inOffsets[start] : adjacency.offsets[start];
+    int x = firstEnd;
+    circuit.reserve(static_cast<size_t>(edgeCount) + 1);
+    circuit.push_back(start);
+    for (int i = 0; i < edgeCount; i++) {
+        if ((i & 0xFFFF) == 0xFFFF && context.charge(0x10000)) return false;
+        x = twin[partner[x]];
+        circuit.push_back(at[x]);
+    }
+    if (x != firstEnd) {
+        throw std::logic_error("Euler tour did not close; is the graph connected and balanced?");
+    }
+    return true;
+}
@@ -0,0 +1,38 @@
+#ifndef EULER_TOUR_H
+#define EULER_TOUR_H
+
+#include "GraphAnalysisContext.h"
+#include "ExecutionContext.h"
+#include <cstddef>
+#include <vector>
+
+// Euler circuit construction for very large graphs, in parallel passes over
+// vertex chunks on the shared pool; Graph's Hierholzer follows one edge at a
+// time.
+//
+// Every edge has two ends, one at each endpoint (an out-end and an in-end
+// when directed). Pairing up the ends at every vertex (any two when
+// undirected, an in-end with an out-end when directed) splits the edges into
+// closed trails: arrive through one end, leave through its partner. Pairing
+// is local to each vertex, and the trails are labeled with the lock-free
+// union-find of AfforestComponents. Two pairs of one vertex that lie on
+// different trails are spliced by exchanging their partners, which joins
+// the two trails into one. A second union-find pass accepts exactly one
+// splice per join, so the splices form a spanning forest and a single
+// closed trail is left. Walking it writes the circuit; that walk is the one
+// sequential pass. Which splices are accepted depends on thread timing, so
+// two runs may return different circuits, both valid.
+//
+// The graph must be connected and balanced (even degrees, or in-degree equal
+// to out-degree) and have no self-loops, which the adjacency arrays drop.
+class ParallelEulerTour {
+public:
+    static constexpr size_t CHUNK_EDGES = 16384;
+
+    // Fills circuit with a closed trail over every edge, starting and ending
+    // at the smallest vertex with an edge; false if the context stopped it
+    static bool run(const AdjacencyArray& adjacency, bool directed, std::vector<int>& circuit,
+                    ExecutionContext& context);
+};
+
+#endif
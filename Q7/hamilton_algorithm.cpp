@@ -1,51 +1,84 @@
 #include "hamilton_algorithm.h"
+#include "hamilton_search.h"
+#include "ThreadPool.h"
+#include <algorithm>
 #include <chrono>
-#include <sstream>
 
-AlgorithmResult HamiltonAlgorithm::execute(const Graph& graph) {
+HamiltonAlgorithm::HamiltonAlgorithm(int dpMaxVertices, int searchMaxVertices)
+    : dpMaxVertices(std::min(dpMaxVertices, DP_HARD_LIMIT)), searchMaxVertices(searchMaxVertices) {}
+
+AlgorithmResult HamiltonAlgorithm::execute(GraphAnalysisContext& analysis, ExecutionContext& context) {
+    const Graph& graph = analysis.getGraph();
     auto start = std::chrono::high_resolution_clock::now();
     AlgorithmResult result;
     
     try {
         int n = graph.getVertexCount();
         
+        result.kind = ResultKind::HAMILTON_CIRCUIT;
         if (n == 0) {
             result.success = true;
-            result.result = "YES (trivial case)";
+            result.found = true;
             return result;
         }
         
-        if (n > 10) {
+        bool fitsDP = n <= dpMaxVertices;
+        bool fitsSearch = !graph.isDirected() && n > SEARCH_MIN_VERTICES && n <= searchMaxVertices;
+        double averageDegree = graph.isDirected() ? 0.0 : 2.0 * graph.getEdgeCount() / n;
+        
+        if (!fitsDP && !fitsSearch) {
             result.success = false;
-            result.error = "Graph too large for brute force Hamilton circuit (max 10 vertices)";
+            if (graph.isDirected() || n <= SEARCH_MIN_VERTICES) {
+                result.error = "Graph too large for exact Hamilton circuit search (max " + std::to_string(dpMaxVertices) + " vertices)";
+            } else {
+                result.error = "Graph too large for Hamilton circuit search (max " + std::to_string(searchMaxVertices) + " vertices)";
+            }
             return result;
         }
         
-        std::vector<int> path(n);
-        std::vector<bool> visited(n, false);
+        std::vector<int> path;
+        std::vector<int> longestPath;
+        bool foundCircuit = false;
+        bool decided = false;
+        std::string gaveUp;
         
-        // Try starting from vertex 0
-        path[0] = 0;
-        visited[0] = true;
-        
-        bool foundCircuit = findHamiltonCircuit(graph, path, visited, 1);
-        
-        std::ostringstream output;
-        output << (foundCircuit ? "YES" : "NO");
+        if (fitsSearch && (!fitsDP || averageDegree <= SPARSE_MAX_AVERAGE_DEGREE)) {
+            HamiltonSearch search(analysis.adjacency(), SEARCH_STEP_LIMIT, context);
+            HamiltonSearch::Outcome outcome = search.run(path);
+            longestPath = search.getLongestPath();
+            if (outcome == HamiltonSearch::Outcome::INTERRUPTED) {
+                decided = true;
+            } else if (outcome != HamiltonSearch::Outcome::GAVE_UP) {
+                foundCircuit = outcome == HamiltonSearch::Outcome::FOUND;
+                decided = true;
+            } else if (!fitsDP) {
+                gaveUp = "Hamilton circuit search gave up after " + std::to_string(search.getSteps()) + " steps";
+                decided = true;
+            }
+        }
         
-        if (foundCircuit && n <= 8) {
-            output << " - Circuit: ";
-            for (int i = 0; i < n; i++) {
-                output << path[i];
-                if (i < n - 1) output << "->";
+        if (!decided) {
+            std::vector<int> dpPath;
+            foundCircuit = findCircuitHeldKarp(analysis, path, dpPath, context);
+            if (dpPath.size() > longestPath.size()) {
+                longestPath.swap(dpPath);
             }
-            output << "->" << path[0]; // Complete the circuit
-        } else if (foundCircuit) {
-            output << " - Circuit found (length: " << n << ")";
         }
         
-        result.success = true;
-        result.result = output.str();
+        if (!foundCircuit && (context.isStopped() || !gaveUp.empty())) {
+            // No verdict: the longest path seen is the best partial answer
+            result.vertices.swap(longestPath);
+            result.upperBound = n;
+            result.interrupted = context.isStopped();
+            result.markPartial(context.isStopped() ? context.describeStop() : gaveUp);
+        } else {
+            result.found = foundCircuit;
+            if (foundCircuit) {
+                result.vertices.swap(path);
+                result.vertices.push_back(result.vertices[0]); // Close the circuit
+            }
+            result.success = true;
+        }
         
     } catch (const std::exception& e) {
         result.success = false;
@@ -58,36 +91,154 @@ AlgorithmResult HamiltonAlgorithm::execute(const Graph& graph) {
     return result;
 }
 
-bool HamiltonAlgorithm::findHamiltonCircuit(const Graph& graph, std::vector<int>& path, 
-                                           std::vector<bool>& visited, int pos) {
+// Fills reach[] for the subsets (prefix << lowBits) | low where low has
+// exactly lowCount bits set. Bit i of a subset or endpoint set is vertex i + 1.
+void HamiltonAlgorithm::computeLayer(std::vector<uint32_t>& reach, const std::vector<uint32_t>& predecessors,
+                                     int lowBits, uint32_t prefix, int lowCount, std::atomic<uint32_t>& witness,
+                                     ExecutionContext& context) {
+    uint64_t high = static_cast<uint64_t>(prefix) << lowBits;
+    uint64_t limit = 1ULL << lowBits;
+    uint64_t low = (1ULL << lowCount) - 1;
+    int sincePoll = 0;
+    uint32_t reachable = 0;
+    
+    while (low < limit) {
+        if (++sincePoll == POLL_INTERVAL) {
+            sincePoll = 0;
+            if (context.charge(POLL_INTERVAL)) break;
+        }
+        
+        uint32_t subset = static_cast<uint32_t>(high | low);
+        uint32_t endpoints = 0;
+        uint32_t remaining = subset;
+        while (remaining) {
+            int v = __builtin_ctz(remaining);
+            uint32_t bit = remaining & (~remaining + 1);
+            remaining ^= bit;
+            // v ends a path over subset iff some path over subset - {v} ends next to it
+            if (reach[subset ^ bit] & predecessors[v]) {
+                endpoints |= bit;
+            }
+        }
+        reach[subset] = endpoints;
+        if (endpoints && !reachable) reachable = subset;
+        
+        if (low == 0) break;
+        // Next value with the same popcount (Gosper's hack)
+        uint64_t lowest = low & (~low + 1);
+        uint64_t ripple = low + lowest;
+        low = (((ripple ^ low) >> 2) / lowest) | ripple;
+    }
+    
+    // Any subset a path can cover will do as a witness for the layer
+    if (reachable) witness.store(reachable, std::memory_order_relaxed);
+}
+
+// Rebuilds a path 0 -> ... -> v over subset, for some v in endpoints, by
+// walking the table backwards
+void HamiltonAlgorithm::tracePath(const std::vector<uint32_t>& reach, const std::vector<uint32_t>& predecessors,
+                                  uint32_t subset, uint32_t endpoints, std::vector<int>& path) {
+    int length = __builtin_popcount(subset) + 1;
+    path.assign(length, 0);
+    int current = __builtin_ctz(endpoints);
+    for (int pos = length - 1; pos >= 1; pos--) {
+        path[pos] = current + 1;
+        subset ^= 1u << current;
+        if (pos > 1) {
+            current = __builtin_ctz(reach[subset] & predecessors[current]);
+        }
+    }
+}
+
+bool HamiltonAlgorithm::findCircuitHeldKarp(GraphAnalysisContext& analysis, std::vector<int>& circuit,
+                                            std::vector<int>& longestPath, ExecutionContext& context) {
+    const Graph& graph = analysis.getGraph();
     int n = graph.getVertexCount();
+    longestPath.assign(1, 0);
+    
+    if (n == 1) {
+        circuit.assign(1, 0);
+        return graph.hasEdge(0, 0);
+    }
+    
+    // Full-width rows: bit u of predecessors[v] is an edge u -> v. The
+    // shared bitset rows already hold out[] in their first word.
+    const std::vector<Bitset>& rows = analysis.bitsetAdjacency();
+    std::vector<uint32_t> in(n, 0), out(n, 0);
+    for (int u = 0; u < n; u++) {
+        out[u] = static_cast<uint32_t>(rows[u].word(0));
+        for (uint32_t targets = out[u]; targets; targets &= targets - 1) {
+            in[__builtin_ctz(targets)] |= 1u << u;
+        }
+    }
+    
+    // Cheap rejection: every vertex needs a way in and a way out, and in an
+    // undirected graph on 3+ vertices those must be two distinct neighbors
+    int minDegree = (!graph.isDirected() && n >= 3) ? 2 : 1;
+    for (int v = 0; v < n; v++) {
+        if (__builtin_popcount(in[v]) < minDegree || __builtin_popcount(out[v]) < minDegree) {
+            return false;
+        }
+    }
     
-    if (pos == n) {
-        // All vertices visited, check if we can return to start
-        return graph.hasEdge(path[pos - 1], path[0]);
+    // DP over vertices 1..n-1, bit i standing for vertex i + 1
+    int m = n - 1;
+    std::vector<uint32_t> predecessors(m);
+    for (int i = 0; i < m; i++) {
+        predecessors[i] = in[i + 1] >> 1;
     }
+    uint32_t fromStart = out[0] >> 1;
+    uint32_t toStart = in[0] >> 1;
     
-    for (int v = 1; v < n; v++) { // Start from 1 since 0 is already in path
-        if (isValidNext(graph, v, path, pos) && !visited[v]) {
-            path[pos] = v;
-            visited[v] = true;
-            
-            if (findHamiltonCircuit(graph, path, visited, pos + 1)) {
-                return true;
+    std::vector<uint32_t> reach(size_t(1) << m, 0);
+    for (int i = 0; i < m; i++) {
+        if (fromStart & (1u << i)) {
+            reach[1u << i] = 1u << i;
+        }
+    }
+    // Largest subset known to be covered by a path from 0, for partial answers
+    uint32_t deepest = fromStart ? (fromStart & (~fromStart + 1)) : 0;
+    std::atomic<uint32_t> witness(0);
+    
+    // Split each layer by the top prefixBits bits of the subset: one task per prefix
+    ThreadPool& pool = ThreadPool::shared();
+    bool parallel = n >= PARALLEL_MIN_VERTICES && pool.size() > 1;
+    int prefixBits = parallel ? std::min(6, m - 8) : 0;
+    int lowBits = m - prefixBits;
+    
+    for (int layer = 2; layer <= m; layer++) {
+        witness.store(0, std::memory_order_relaxed);
+        if (!parallel) {
+            computeLayer(reach, predecessors, lowBits, 0, layer, witness, context);
+        } else {
+            TaskGroup group(pool);
+            for (uint32_t prefix = 0; prefix < (1u << prefixBits); prefix++) {
+                int lowCount = layer - __builtin_popcount(prefix);
+                if (lowCount < 0 || lowCount > lowBits) continue;
+                group.run([&reach, &predecessors, &witness, &context, lowBits, prefix, lowCount]() {
+                    computeLayer(reach, predecessors, lowBits, prefix, lowCount, witness, context);
+                });
             }
-            
-            // Backtrack
-            visited[v] = false;
+            group.wait();
         }
+        // Entries of a partial layer are final too, so its witness still counts
+        uint32_t covered = witness.load(std::memory_order_relaxed);
+        if (covered) deepest = covered;
+        if (context.isStopped() || !covered) break;
     }
     
-    return false;
-}
-
-bool HamiltonAlgorithm::isValidNext(const Graph& graph, int v, const std::vector<int>& path, int pos) {
-    // Check if vertex v can be added at position pos
-    if (pos == 0) return true;
+    if (deepest) {
+        tracePath(reach, predecessors, deepest, reach[deepest], longestPath);
+    }
+    if (context.isStopped()) return false;
     
-    // Check if there's an edge from previous vertex to v
-    return graph.hasEdge(path[pos - 1], v);
-}
\ No newline at end of file
+    uint32_t full = (m == 32) ? ~0u : (1u << m) - 1;
+    uint32_t closing = reach[full] & toStart;
+    if (!closing) {
+        return false;
+    }
+    
+    // Walk the table backwards from an endpoint that closes the circuit
+    tracePath(reach, predecessors, full, closing, circuit);
+    return true;
+}
@@ -2,18 +2,63 @@
 #define HAMILTON_ALGORITHM_H
 
 #include "BaseAlgorithm.h"
+#include <atomic>
+#include <cstdint>
 #include <vector>
 
+// Exact Hamilton circuit by Held-Karp dynamic programming. The circuit is
+// anchored at vertex 0; for every subset S of the other vertices the table
+// holds the set of endpoints v such that some path 0 -> ... -> v visits
+// exactly S. Both subsets and endpoint sets are packed 32-bit masks, so a
+// transition is a handful of AND/OR operations. Subsets of equal size only
+// depend on the previous size, so each layer is split across the shared
+// thread pool.
+//
+// Sparse undirected graphs, and undirected graphs beyond the DP limit, go to
+// the pruned backtracking search in hamilton_search.h instead. If that search
+// runs out of steps on a graph the DP can still handle, the DP decides.
+//
+// When no exact answer is reached (the context stops the run, or the search
+// gives up beyond the DP limit) the result is "UNKNOWN" with the longest
+// simple path from the start vertex found so far, marked as not exact.
 class HamiltonAlgorithm : public BaseAlgorithm {
 public:
-    AlgorithmResult execute(const Graph& graph) override;
+    static constexpr int DEFAULT_DP_MAX_VERTICES = 25;
+    // The table holds 2^(n-1) 32-bit endpoint masks, 64 MiB at 25 vertices
+    // and 2 GiB at 30; requests run concurrently, so the environment can only
+    // lower this
+    static constexpr int DP_HARD_LIMIT = 25;
+    static constexpr int PARALLEL_MIN_VERTICES = 18;
+
+    static constexpr int DEFAULT_SEARCH_MAX_VERTICES = 500;
+    // Below this size the DP is always cheap enough
+    static constexpr int SEARCH_MIN_VERTICES = 16;
+    // Average degree up to which a graph the DP could solve is searched first
+    static constexpr double SPARSE_MAX_AVERAGE_DEGREE = 6.0;
+    static constexpr long long SEARCH_STEP_LIMIT = 2000000;
+    // DP subsets between checks of the execution context
+    static constexpr int POLL_INTERVAL = 4096;
+
+    explicit HamiltonAlgorithm(int dpMaxVertices = DEFAULT_DP_MAX_VERTICES,
+                               int searchMaxVertices = DEFAULT_SEARCH_MAX_VERTICES);
+
+    using BaseAlgorithm::execute;
+    AlgorithmResult execute(GraphAnalysisContext& analysis, ExecutionContext& context) override;
     std::string getName() const override { return "Hamilton Circuit"; }
     bool supportsDirected() const override { return true; }
     bool supportsUndirected() const override { return true; }
 
 private:
-    bool findHamiltonCircuit(const Graph& graph, std::vector<int>& path, std::vector<bool>& visited, int pos);
-    bool isValidNext(const Graph& graph, int v, const std::vector<int>& path, int pos);
+    int dpMaxVertices;
+    int searchMaxVertices;
+
+    bool findCircuitHeldKarp(GraphAnalysisContext& analysis, std::vector<int>& circuit,
+                             std::vector<int>& longestPath, ExecutionContext& context);
+    static void computeLayer(std::vector<uint32_t>& reach, const std::vector<uint32_t>& predecessors,
+                             int lowBits, uint32_t prefix, int lowCount, std::atomic<uint32_t>& witness,
+                             ExecutionContext& context);
+    static void tracePath(const std::vector<uint32_t>& reach, const std::vector<uint32_t>& predecessors,
+                          uint32_t subset, uint32_t endpoints, std::vector<int>& path);
 };
 
-#endif
\ No newline at end of file
+#endif
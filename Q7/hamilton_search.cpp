@@ -0,0 +1,426 @@
+#include "hamilton_search.h"
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace {
+// Tie-break rank of a vertex among equally constrained moves in one round
+uint32_t shuffleRank(int v, uint32_t seed) {
+    uint32_t x = static_cast<uint32_t>(v) ^ (seed * 0x9E3779B9u);
+    x ^= x >> 16;
+    x *= 0x85EBCA6Bu;
+    x ^= x >> 13;
+    return x;
+}
+}
+
+// Depth-first search state of one task. The path always starts at the
+// search's start vertex; "usable" counts, for every vertex, the neighbors
+// that are still unvisited or are one of the two path ends, i.e. the
+// neighbors it could still be joined to in the finished circuit.
+class HamiltonSearch::Worker {
+public:
+    explicit Worker(HamiltonSearch& search);
+
+    // Appends v (an unvisited neighbor of the current end) to the path.
+    // Returns false if the new state is already hopeless; the move must
+    // still be undone with retract().
+    bool extend(int v);
+    void retract();
+
+    bool search();
+    void flushSteps();
+
+    const std::vector<int>& getPath() const { return path; }
+    const std::vector<int>& getLongestPath() const { return longest; }
+
+private:
+    static constexpr int STEP_BATCH = 1024;
+
+    HamiltonSearch& owner;
+    const std::vector<int>& offsets;
+    const std::vector<int>& targets;
+    int start;
+
+    std::vector<int> path;
+    std::vector<int> longest;   // Longest path reached so far, kept for partial answers
+    std::vector<char> onPath;
+    std::vector<char> nextToStart;
+    std::vector<int> usable;
+    int remaining;
+    int startFree;          // Unvisited neighbors of the start vertex
+    long long localSteps;
+
+    // Candidate moves of every open search level, stacked
+    std::vector<int> candidates;
+
+    // Lowpoint DFS scratch, reused across calls via the epoch stamp
+    struct Frame {
+        int vertex;
+        int parent;
+        int nextEdge;
+    };
+    std::vector<Frame> frames;
+    std::vector<int> stamp;
+    std::vector<int> disc;
+    std::vector<int> low;
+    int epoch;
+
+    // Forced edges incident to each vertex and union-find over the forced
+    // edges, also stamped by epoch
+    std::vector<int> forcedStamp;
+    std::vector<int> forcedDegree;
+    std::vector<int> segment;
+
+    int degree(int v) const { return offsets[v + 1] - offsets[v]; }
+    bool isRemaining(int v, int end) const { return !onPath[v] || v == end || v == start; }
+    void touch(int v);
+    int findSegment(int v);
+    bool tick();
+    bool forcedEdgesFit();
+    bool remainderIsBiconnected();
+};
+
+HamiltonSearch::Worker::Worker(HamiltonSearch& search)
+    : owner(search), offsets(search.offsets), targets(search.targets), start(search.start),
+      onPath(search.vertexCount, 0), nextToStart(search.vertexCount, 0),
+      usable(search.vertexCount), remaining(search.vertexCount - 1), startFree(degree(search.start)),
+      localSteps(0), stamp(search.vertexCount, 0), disc(search.vertexCount), low(search.vertexCount),
+      epoch(0), forcedStamp(search.vertexCount, 0), forcedDegree(search.vertexCount),
+      segment(search.vertexCount) {
+    for (int v = 0; v < search.vertexCount; v++) {
+        usable[v] = degree(v);
+    }
+    for (int i = offsets[start]; i < offsets[start + 1]; i++) {
+        nextToStart[targets[i]] = 1;
+    }
+    path.reserve(search.vertexCount);
+    path.push_back(start);
+    onPath[start] = 1;
+}
+
+bool HamiltonSearch::Worker::extend(int v) {
+    int end = path.back();
+    path.push_back(v);
+    onPath[v] = 1;
+    remaining--;
+    if (nextToStart[v]) startFree--;
+
+    bool viable = true;
+    // The old end becomes an interior vertex: its neighbors lose an option
+    if (end != start) {
+        for (int i = offsets[end]; i < offsets[end + 1]; i++) {
+            int w = targets[i];
+            usable[w]--;
+            if (!onPath[w] && usable[w] < 2) viable = false;
+        }
+    }
+    if (remaining > 0 && startFree == 0) viable = false;
+    return viable;
+}
+
+void HamiltonSearch::Worker::retract() {
+    int v = path.back();
+    path.pop_back();
+    int end = path.back();
+    if (end != start) {
+        for (int i = offsets[end]; i < offsets[end + 1]; i++) {
+            usable[targets[i]]++;
+        }
+    }
+    onPath[v] = 0;
+    remaining++;
+    if (nextToStart[v]) startFree++;
+}
+
+bool HamiltonSearch::Worker::tick() {
+    if (++localSteps == STEP_BATCH) {
+        flushSteps();
+    }
+    return !owner.stop.load(std::memory_order_relaxed);
+}
+
+void HamiltonSearch::Worker::flushSteps() {
+    if (localSteps == 0) return;
+    long long total = owner.steps.fetch_add(localSteps) + localSteps;
+    bool interrupted = owner.context.charge(localSteps);
+    localSteps = 0;
+    if (total > owner.roundLimit) {
+        owner.budgetSpent.store(true);
+        owner.stop.store(true);
+    }
+    if (interrupted) {
+        owner.stop.store(true);
+    }
+}
+
+void HamiltonSearch::Worker::touch(int v) {
+    if (forcedStamp[v] != epoch) {
+        forcedStamp[v] = epoch;
+        forcedDegree[v] = 0;
+        segment[v] = v;
+    }
+}
+
+int HamiltonSearch::Worker::findSegment(int v) {
+    while (segment[v] != v) {
+        segment[v] = segment[segment[v]];
+        v = segment[v];
+    }
+    return v;
+}
+
+// Every unvisited vertex with two usable neighbors forces both edges. An
+// unvisited vertex can take two circuit edges, a path end only one (the
+// start two while the path is a single vertex). Forced edges must also not
+// close a cycle, the path counting as an edge between its ends, unless that
+// cycle is the whole circuit.
+bool HamiltonSearch::Worker::forcedEdgesFit() {
+    int end = path.back();
+    epoch++;
+
+    int members = remaining + 1;
+    if (end != start) {
+        members++;
+        touch(end);
+        touch(start);
+        segment[end] = start;
+    }
+
+    int forcedEdges = 0;
+    bool closed = false;
+    for (int w = 0; w < static_cast<int>(onPath.size()); w++) {
+        if (onPath[w] || usable[w] != 2) continue;
+        touch(w);
+        for (int i = offsets[w]; i < offsets[w + 1]; i++) {
+            int y = targets[i];
+            if (!isRemaining(y, end)) continue;
+            touch(y);
+            int capacity = (!onPath[y] || end == start) ? 2 : 1;
+            if (++forcedDegree[y] > capacity) return false;
+
+            // An edge between two such vertices is seen from both sides
+            if (!onPath[y] && usable[y] == 2 && y < w) continue;
+            forcedEdges++;
+            int a = findSegment(w);
+            int b = findSegment(y);
+            if (a == b) {
+                closed = true;
+            } else {
+                segment[a] = b;
+            }
+        }
+    }
+
+    return !closed || forcedEdges + (end != start ? 1 : 0) == members;
+}
+
+// What is left to find is a Hamilton cycle in the graph of unvisited vertices
+// plus both path ends, with a virtual edge between the ends. Such a graph must
+// be connected and free of articulation points.
+bool HamiltonSearch::Worker::remainderIsBiconnected() {
+    int end = path.back();
+    int members = remaining + (end == start ? 1 : 2);
+    if (members < 4) return true;
+
+    epoch++;
+    int time = 0;
+    int reached = 1;
+    int rootChildren = 0;
+
+    frames.clear();
+    frames.push_back({end, -1, offsets[end]});
+    stamp[end] = epoch;
+    disc[end] = low[end] = time++;
+
+    while (!frames.empty()) {
+        Frame& frame = frames.back();
+        int u = frame.vertex;
+
+        // Real edges first, then the virtual edge between the two ends
+        int w = -1;
+        if (frame.nextEdge < offsets[u + 1]) {
+            w = targets[frame.nextEdge++];
+        } else if (frame.nextEdge == offsets[u + 1] && end != start && (u == end || u == start)) {
+            frame.nextEdge++;
+            w = (u == end) ? start : end;
+        } else {
+            int parent = frame.parent;
+            frames.pop_back();
+            if (parent >= 0) {
+                low[parent] = std::min(low[parent], low[u]);
+                if (parent != end && low[u] >= disc[parent]) {
+                    return false;
+                }
+            }
+            continue;
+        }
+
+        if (w == frame.parent || !isRemaining(w, end)) continue;
+
+        if (stamp[w] != epoch) {
+            stamp[w] = epoch;
+            disc[w] = low[w] = time++;
+            reached++;
+            if (u == end) rootChildren++;
+            frames.push_back({w, u, offsets[w]});
+        } else {
+            low[u] = std::min(low[u], disc[w]);
+        }
+    }
+
+    return reached == members && rootChildren <= 1;
+}
+
+bool HamiltonSearch::Worker::search() {
+    if (!tick()) return false;
+
+    if (path.size() > longest.size()) {
+        longest = path;
+    }
+
+    int end = path.back();
+    if (remaining == 0) {
+        return nextToStart[end];
+    }
+
+    // An unvisited neighbor with only two options left must be joined to
+    // the end now
+    size_t base = candidates.size();
+    int forced = -1;
+    for (int i = offsets[end]; i < offsets[end + 1]; i++) {
+        int w = targets[i];
+        if (onPath[w]) continue;
+        candidates.push_back(w);
+        if (usable[w] == 2) forced = w;
+    }
+
+    bool viable = forcedEdgesFit() && remainderIsBiconnected();
+    if (!viable) {
+        candidates.resize(base);
+        return false;
+    }
+
+    if (forced >= 0) {
+        candidates.resize(base);
+        candidates.push_back(forced);
+    } else {
+        // Warnsdorff: the neighbor with the fewest options left goes first
+        uint32_t seed = owner.roundSeed;
+        std::sort(candidates.begin() + base, candidates.end(), [this, seed](int a, int b) {
+            if (usable[a] != usable[b]) return usable[a] < usable[b];
+            return shuffleRank(a, seed) < shuffleRank(b, seed);
+        });
+    }
+
+    size_t top = candidates.size();
+    for (size_t i = base; i < top; i++) {
+        int v = candidates[i];
+        bool extended = extend(v);
+        if (extended && search()) {
+            candidates.resize(base);
+            return true;
+        }
+        retract();
+        if (owner.stop.load(std::memory_order_relaxed)) break;
+    }
+
+    candidates.resize(base);
+    return false;
+}
+
+HamiltonSearch::HamiltonSearch(const AdjacencyArray& adjacency, long long stepLimit, ExecutionContext& context)
+    : vertexCount(static_cast<int>(adjacency.offsets.size()) - 1), offsets(adjacency.offsets),
+      targets(adjacency.targets), start(0), context(context), stepLimit(stepLimit),
+      steps(0), roundLimit(0), roundSeed(0), stop(false), budgetSpent(false), found(false) {
+    for (int v = 0; v < vertexCount; v++) {
+        if (adjacency.degree(v) < adjacency.degree(start)) {
+            start = v;
+        }
+    }
+}
+
+// Paths of up to MAX_PREFIX_DEPTH extra vertices from the start, enough of
+// them to keep every worker busy. Together they cover the whole search tree.
+std::vector<std::vector<int>> HamiltonSearch::buildPrefixes(int taskTarget) const {
+    std::vector<std::vector<int>> prefixes{{start}};
+
+    for (int depth = 0; depth < MAX_PREFIX_DEPTH && static_cast<int>(prefixes.size()) < taskTarget; depth++) {
+        std::vector<std::vector<int>> longer;
+        for (const auto& prefix : prefixes) {
+            int end = prefix.back();
+            for (int i = offsets[end]; i < offsets[end + 1]; i++) {
+                int w = targets[i];
+                if (std::find(prefix.begin(), prefix.end(), w) != prefix.end()) continue;
+                longer.push_back(prefix);
+                longer.back().push_back(w);
+            }
+        }
+        prefixes.swap(longer);
+    }
+    return prefixes;
+}
+
+void HamiltonSearch::runPrefix(const std::vector<int>& prefix) {
+    if (stop.load()) return;
+
+    Worker worker(*this);
+    bool viable = true;
+    for (size_t i = 1; i < prefix.size() && viable; i++) {
+        viable = worker.extend(prefix[i]);
+    }
+
+    bool success = viable && worker.search();
+    worker.flushSteps();
+
+    std::lock_guard<std::mutex> lock(resultMutex);
+    if (worker.getLongestPath().size() > longestPath.size()) {
+        longestPath = worker.getLongestPath();
+    }
+    if (success) {
+        if (!found) {
+            found = true;
+            foundCircuit = worker.getPath();
+        }
+        stop.store(true);
+    }
+}
+
+void HamiltonSearch::runRound() {
+    ThreadPool& pool = ThreadPool::shared();
+    if (pool.size() > 1) {
+        std::vector<std::vector<int>> prefixes = buildPrefixes(pool.size() * TASKS_PER_THREAD);
+        TaskGroup group(pool);
+        for (const auto& prefix : prefixes) {
+            group.run([this, &prefix]() { runPrefix(prefix); });
+        }
+        group.wait();
+    } else {
+        runPrefix({start});
+    }
+}
+
+HamiltonSearch::Outcome HamiltonSearch::run(std::vector<int>& circuit) {
+    if (vertexCount < 3) return Outcome::NONE;
+    for (int v = 0; v < vertexCount; v++) {
+        if (offsets[v + 1] - offsets[v] < 2) return Outcome::NONE;
+    }
+
+    long long budget = FIRST_ROUND_STEPS;
+    for (uint32_t round = 0; ; round++) {
+        roundSeed = round;
+        roundLimit = std::min(stepLimit, steps.load() + budget);
+        stop.store(false);
+        budgetSpent.store(false);
+
+        runRound();
+
+        if (found) {
+            circuit = foundCircuit;
+            return Outcome::FOUND;
+        }
+        if (context.isStopped()) return Outcome::INTERRUPTED;
+        if (!budgetSpent.load()) return Outcome::NONE;
+        if (steps.load() >= stepLimit) return Outcome::GAVE_UP;
+        budget *= 2;
+    }
+}
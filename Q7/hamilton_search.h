@@ -0,0 +1,69 @@
+#ifndef HAMILTON_SEARCH_H
+#define HAMILTON_SEARCH_H
+
+#include "GraphAnalysisContext.h"
+#include "ExecutionContext.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Pruned backtracking for Hamilton circuits in undirected graphs too large
+// for the subset DP. The path grows from a minimum-degree vertex; at every
+// node the search
+//   - rejects when an unvisited vertex has fewer than two usable neighbors,
+//   - follows forced edges into vertices with exactly two usable neighbors,
+//   - rejects unless the unvisited vertices plus both path ends, joined by a
+//     virtual end-to-end edge, form a connected graph without articulation
+//     points (a Hamilton cycle in it is what is left to find),
+//   - tries the remaining moves in Warnsdorff order (fewest options first).
+// Top-level path prefixes run as tasks on the shared thread pool and stop
+// cooperatively once any task finds a circuit or the round's step budget is
+// spent. Running times are heavy-tailed, so the search restarts with a new
+// tie-break order and a doubled budget until a round finishes (a complete
+// round is an exact answer) or the overall step limit is reached. Steps are
+// also charged to the caller's execution context, which can stop the search.
+// The longest simple path reached by any round is kept for callers that
+// want a partial answer when no exact one is available.
+class HamiltonSearch {
+public:
+    enum class Outcome { FOUND, NONE, GAVE_UP, INTERRUPTED };
+
+    static constexpr int TASKS_PER_THREAD = 8;
+    static constexpr int MAX_PREFIX_DEPTH = 4;
+    static constexpr long long FIRST_ROUND_STEPS = 1000;
+
+    HamiltonSearch(const AdjacencyArray& adjacency, long long stepLimit, ExecutionContext& context);
+
+    Outcome run(std::vector<int>& circuit);
+    long long getSteps() const { return steps.load(); }
+    const std::vector<int>& getLongestPath() const { return longestPath; }
+
+private:
+    class Worker;
+
+    int vertexCount;
+    // Simple-graph adjacency in CSR form, shared with the other algorithms
+    const std::vector<int>& offsets;
+    const std::vector<int>& targets;
+    int start;
+
+    ExecutionContext& context;
+    long long stepLimit;
+    std::atomic<long long> steps;
+    long long roundLimit;       // Value of steps at which the current round ends
+    uint32_t roundSeed;         // Tie-break order of the current round
+    std::atomic<bool> stop;
+    std::atomic<bool> budgetSpent;
+
+    std::mutex resultMutex;
+    bool found;
+    std::vector<int> foundCircuit;
+    std::vector<int> longestPath;
+
+    std::vector<std::vector<int>> buildPrefixes(int taskTarget) const;
+    void runRound();
+    void runPrefix(const std::vector<int>& prefix);
+};
+
+#endif
@@ -0,0 +1,36 @@
+#include "kcore_algorithm.h"
+#include <chrono>
+
+AlgorithmResult KCoreAlgorithm::execute(GraphAnalysisContext& analysis, ExecutionContext& context) {
+    const Graph& graph = analysis.getGraph();
+    auto start = std::chrono::high_resolution_clock::now();
+    AlgorithmResult result;
+    
+    try {
+        if (graph.isDirected()) {
+            result.success = false;
+            result.error = "K-core decomposition works only on undirected graphs";
+            return result;
+        }
+        
+        if (context.check()) {
+            result.markInterrupted(context);
+            return result;
+        }
+        
+        const CoreDecomposition& cores = analysis.cores();
+        result.kind = ResultKind::CORES;
+        result.vertices = cores.coreOf;
+        result.weight = cores.degeneracy;
+        result.success = true;
+        
+    } catch (const std::exception& e) {
+        result.success = false;
+        result.error = e.what();
+    }
+    
+    auto end = std::chrono::high_resolution_clock::now();
+    result.executionTime = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    
+    return result;
+}
@@ -0,0 +1,17 @@
+#ifndef KCORE_ALGORITHM_H
+#define KCORE_ALGORITHM_H
+
+#include "BaseAlgorithm.h"
+
+// Core number of every vertex by the O(V + E) bucket algorithm of
+// Batagelj and Zaversnik (GraphAnalysisContext::cores()).
+class KCoreAlgorithm : public BaseAlgorithm {
+public:
+    using BaseAlgorithm::execute;
+    AlgorithmResult execute(GraphAnalysisContext& analysis, ExecutionContext& context) override;
+    std::string getName() const override { return "K-Core Decomposition"; }
+    bool supportsDirected() const override { return false; }
+    bool supportsUndirected() const override { return true; }
+};
+
+#endif
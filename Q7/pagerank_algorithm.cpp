@@ -0,0 +1,153 @@
+#include "pagerank_algorithm.h"
+#include "ThreadPool.h"
+#include <chrono>
+#include <cmath>
+
+AlgorithmResult PageRankAlgorithm::execute(GraphAnalysisContext& analysis, ExecutionContext& context) {
+    const Graph& graph = analysis.getGraph();
+    auto start = std::chrono::high_resolution_clock::now();
+    AlgorithmResult result;
+
+    try {
+        if (context.check()) {
+            result.markInterrupted(context);
+            return result;
+        }
+
+        const AdjacencyArray& out = analysis.adjacency();
+        const AdjacencyArray& in = analysis.inAdjacency();
+        int n = graph.getVertexCount();
+
+        result.kind = ResultKind::PAGERANK;
+        if (n == 0) {
+            result.success = true;
+            return result;
+        }
+
+        // Chunk boundaries by in-edge count, plus one per row for its own
+        // update, so a chunk holding a hub is not much heavier than others
+        std::vector<int> bounds{0};
+        size_t edgesInChunk = 0;
+        for (int v = 0; v < n; v++) {
+            edgesInChunk += in.degree(v) + 1;
+            if (edgesInChunk >= CHUNK_EDGES) {
+                bounds.push_back(v + 1);
+                edgesInChunk = 0;
+            }
+        }
+        if (bounds.back() != n) bounds.push_back(n);
+        int chunks = static_cast<int>(bounds.size()) - 1;
+
+        // Every array is allocated once; iterations swap the pairs
+        std::vector<double> inverseOutDegree(n);
+        std::vector<double> rank(n, 1.0 / n);
+        std::vector<double> nextRank(n);
+        std::vector<double> contribution(n);
+        std::vector<double> nextContribution(n);
+        std::vector<ChunkSums> sums(chunks);
+        double dangling = 0;
+        for (int v = 0; v < n; v++) {
+            int degree = out.degree(v);
+            inverseOutDegree[v] = degree > 0 ? 1.0 / degree : 0.0;
+            contribution[v] = rank[v] * inverseOutDegree[v];
+            if (degree == 0) dangling += rank[v];
+        }
+
+        ThreadPool& pool = ThreadPool::shared();
+        bool parallel = chunks > 1 && pool.size() > 1;
+        int iterations = 0;
+        bool converged = false;
+        while (iterations < MAX_ITERATIONS) {
+            double base = (1.0 - DAMPING + DAMPING * dangling) / n;
+            auto runChunk = [&](int chunk) {
+                int first = bounds[chunk], last = bounds[chunk + 1];
+                if (context.charge(static_cast<long long>(in.offsets[last] - in.offsets[first]) + (last - first))) {
+                    return;
+                }
+                sums[chunk] = updateRange(in, inverseOutDegree, first, last, base, contribution, rank,
+                                          nextContribution, nextRank);
+            };
+            if (parallel) {
+                TaskGroup group(pool);
+                for (int chunk = 0; chunk < chunks; chunk++) {
+                    group.run([&runChunk, chunk]() { runChunk(chunk); });
+                }
+                group.wait();
+            } else {
+                for (int chunk = 0; chunk < chunks && !context.isStopped(); chunk++) {
+                    runChunk(chunk);
+                }
+            }
+            if (context.isStopped()) break;
+
+            double change = 0;
+            dangling = 0;
+            for (const ChunkSums& chunk : sums) {
+                change += chunk.change;
+                dangling += chunk.dangling;
+            }
+            rank.swap(nextRank);
+            contribution.swap(nextContribution);
+            iterations++;
+            if (change < TOLERANCE) {
+                converged = true;
+                break;
+            }
+        }
+
+        if (context.isStopped() && iterations == 0) {
+            result.markInterrupted(context);
+        } else {
+            result.weight = iterations;
+            result.values.swap(rank);
+            result.success = true;
+            if (context.isStopped()) {
+                result.interrupted = true;
+                result.markPartial(context.describeStop());
+            } else if (!converged) {
+                result.markPartial("No convergence within " + std::to_string(MAX_ITERATIONS) + " iterations");
+            }
+        }
+
+    } catch (const std::exception& e) {
+        result.success = false;
+        result.error = e.what();
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    result.executionTime = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    return result;
+}
+
+PageRankAlgorithm::ChunkSums PageRankAlgorithm::updateRange(
+        const AdjacencyArray& in, const std::vector<double>& inverseOutDegree, int first, int last,
+        double base, const std::vector<double>& contribution, const std::vector<double>& rank,
+        std::vector<double>& nextContribution, std::vector<double>& nextRank) {
+    ChunkSums sums{0, 0};
+    const double* x = contribution.data();
+    for (int v = first; v < last; v++) {
+        double score = base + DAMPING * gatherSum(x, in.begin(v), in.end(v));
+        sums.change += std::fabs(score - rank[v]);
+        nextRank[v] = score;
+        nextContribution[v] = score * inverseOutDegree[v];
+        if (inverseOutDegree[v] == 0.0) sums.dangling += score;
+    }
+    return sums;
+}
+
+// Four running sums instead of one: each addition no longer waits for the
+// previous one, and the loads of four neighbors are in flight at once
+double PageRankAlgorithm::gatherSum(const double* x, const int* ids, const int* idsEnd) {
+    double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (; idsEnd - ids >= 4; ids += 4) {
+        s0 += x[ids[0]];
+        s1 += x[ids[1]];
+        s2 += x[ids[2]];
+        s3 += x[ids[3]];
+    }
+    for (; ids != idsEnd; ++ids) {
+        s0 += x[*ids];
+    }
+    return (s0 + s1) + (s2 + s3);
+}
@@ -0,0 +1,56 @@
+#ifndef PAGERANK_ALGORITHM_H
+#define PAGERANK_ALGORITHM_H
+
+#include "BaseAlgorithm.h"
+#include <cstddef>
+#include <vector>
+
+// PageRank by power iteration, the scores summing to 1. An undirected edge
+// counts as a link both ways; self-loops are ignored, and a vertex without
+// out-links spreads its score over all vertices.
+//
+// Each iteration is one pull-based sparse matrix-vector product over the
+// in-neighbor CSR: a vertex sums its in-neighbors' score divided by their
+// out-degree, which the previous pass stored in one contiguous array. The
+// sum runs in four independent accumulators, so the loads of consecutive
+// edges overlap instead of waiting on one running sum. Every row writes
+// only its own entries, so rows need no synchronization.
+//
+// Rows are cut into chunks of about CHUNK_EDGES in-edges that run as tasks
+// on the shared pool. Each chunk adds up its own part of the change and of
+// the score without out-links, and the parts are summed in chunk order, so
+// the result does not depend on the thread count or timing.
+//
+// Iteration stops once the L1 change of the scores is below TOLERANCE. If
+// MAX_ITERATIONS pass first or the context stops it, the result holds the
+// scores of the last full iteration, marked as not exact.
+class PageRankAlgorithm : public BaseAlgorithm {
+public:
+    static constexpr double DAMPING = 0.85;
+    static constexpr double TOLERANCE = 1e-6;
+    static constexpr int MAX_ITERATIONS = 200;
+    static constexpr size_t CHUNK_EDGES = 16384;
+
+    using BaseAlgorithm::execute;
+    AlgorithmResult execute(GraphAnalysisContext& analysis, ExecutionContext& context) override;
+    std::string getName() const override { return "PageRank"; }
+    bool supportsDirected() const override { return true; }
+    bool supportsUndirected() const override { return true; }
+
+private:
+    // One iteration's work on the rows of a chunk, and what it adds to the
+    // change and to the score without out-links
+    struct ChunkSums {
+        double change;
+        double dangling;
+    };
+
+    static ChunkSums updateRange(const AdjacencyArray& in, const std::vector<double>& inverseOutDegree,
+                                 int first, int last, double base, const std::vector<double>& contribution,
+                                 const std::vector<double>& rank, std::vector<double>& nextContribution,
+                                 std::vector<double>& nextRank);
+    // Sum of x over a list of vertex ids
+    static double gatherSum(const double* x, const int* ids, const int* idsEnd);
+};
+
+#endif
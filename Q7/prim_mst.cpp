@@ -0,0 +1,141 @@
+#include "prim_mst.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+const long long UNREACHED = std::numeric_limits<long long>::max();
+}
+
+void PrimMST::IndexedHeap::push(int v, long long key, std::vector<long long>& keys) {
+    keys[v] = key;
+    if (position[v] < 0) {
+        heap.push_back(v);
+        position[v] = static_cast<int>(heap.size()) - 1;
+    }
+    siftUp(position[v], keys);
+}
+
+int PrimMST::IndexedHeap::pop(const std::vector<long long>& keys) {
+    int top = heap[0];
+    position[top] = -1;
+    int last = heap.back();
+    heap.pop_back();
+    if (!heap.empty()) {
+        place(0, last);
+        siftDown(0, keys);
+    }
+    return top;
+}
+
+void PrimMST::IndexedHeap::siftUp(int slot, const std::vector<long long>& keys) {
+    int v = heap[slot];
+    while (slot > 0) {
+        int parent = (slot - 1) / HEAP_ARITY;
+        if (keys[heap[parent]] <= keys[v]) break;
+        place(slot, heap[parent]);
+        slot = parent;
+    }
+    place(slot, v);
+}
+
+void PrimMST::IndexedHeap::siftDown(int slot, const std::vector<long long>& keys) {
+    int v = heap[slot];
+    int size = static_cast<int>(heap.size());
+    while (true) {
+        int first = slot * HEAP_ARITY + 1;
+        if (first >= size) break;
+        int best = first;
+        int last = std::min(first + HEAP_ARITY, size);
+        for (int child = first + 1; child < last; child++) {
+            if (keys[heap[child]] < keys[heap[best]]) best = child;
+        }
+        if (keys[heap[best]] >= keys[v]) break;
+        place(slot, heap[best]);
+        slot = best;
+    }
+    place(slot, v);
+}
+
+bool PrimMST::run(const AdjacencyArray& adjacency, const std::vector<int>& weights, Variant variant,
+                  std::vector<Edge>& forest, ExecutionContext& context) {
+    if (variant == Variant::ARRAY) {
+        return runArray(adjacency, weights, forest, context);
+    }
+    return runHeap(adjacency, weights, forest, context);
+}
+
+bool PrimMST::runHeap(const AdjacencyArray& adjacency, const std::vector<int>& weights,
+                      std::vector<Edge>& forest, ExecutionContext& context) {
+    int n = static_cast<int>(adjacency.offsets.size()) - 1;
+    std::vector<long long> keys(n, UNREACHED);
+    std::vector<int> via(n, -1);        // Tree vertex the key's edge comes from
+    std::vector<char> inTree(n, 0);
+    IndexedHeap frontier(n);
+    int settled = 0;
+
+    for (int root = 0; root < n; root++) {
+        if (inTree[root] || adjacency.degree(root) == 0) continue;
+        frontier.push(root, 0, keys);
+
+        while (!frontier.empty()) {
+            if (++settled % POLL_INTERVAL == 0 && context.charge(POLL_INTERVAL)) return false;
+
+            int v = frontier.pop(keys);
+            inTree[v] = 1;
+            if (via[v] >= 0) {
+                forest.emplace_back(via[v], v, static_cast<int>(keys[v]));
+            }
+            for (int i = adjacency.offsets[v]; i < adjacency.offsets[v + 1]; i++) {
+                int u = adjacency.targets[i];
+                if (!inTree[u] && weights[i] < keys[u]) {
+                    via[u] = v;
+                    frontier.push(u, weights[i], keys);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool PrimMST::runArray(const AdjacencyArray& adjacency, const std::vector<int>& weights,
+                       std::vector<Edge>& forest, ExecutionContext& context) {
+    int n = static_cast<int>(adjacency.offsets.size()) - 1;
+    std::vector<long long> keys(n, UNREACHED);
+    std::vector<int> via(n, -1);
+    // Vertices not yet in a tree, kept compact so each scan only visits them
+    std::vector<int> outside;
+    outside.reserve(n);
+    for (int v = 0; v < n; v++) {
+        if (adjacency.degree(v) > 0) outside.push_back(v);
+    }
+    std::vector<char> inTree(n, 0);
+
+    int settled = 0;
+    while (!outside.empty()) {
+        if (++settled % POLL_INTERVAL == 0 && context.charge(static_cast<long long>(POLL_INTERVAL) * outside.size())) {
+            return false;
+        }
+
+        // Cheapest vertex outside; an unreached one starts the next tree
+        size_t best = 0;
+        for (size_t i = 1; i < outside.size(); i++) {
+            if (keys[outside[i]] < keys[outside[best]]) best = i;
+        }
+        int v = outside[best];
+        outside[best] = outside.back();
+        outside.pop_back();
+
+        inTree[v] = 1;
+        if (via[v] >= 0) {
+            forest.emplace_back(via[v], v, static_cast<int>(keys[v]));
+        }
+        for (int i = adjacency.offsets[v]; i < adjacency.offsets[v + 1]; i++) {
+            int u = adjacency.targets[i];
+            if (!inTree[u] && weights[i] < keys[u]) {
+                keys[u] = weights[i];
+                via[u] = v;
+            }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,58 @@
+#ifndef PRIM_MST_H
+#define PRIM_MST_H
+
+#include "Mst_algorithm.h"
+#include "GraphAnalysisContext.h"
+#include "ExecutionContext.h"
+#include <vector>
+
+// Prim's algorithm over the CSR adjacency, growing one tree per component.
+// Two ways to find the next vertex:
+//   - HEAP: an indexed d-ary min-heap of frontier vertices with decrease-key,
+//     O(E log_d V). A wider node makes the heap shallower, which pays off
+//     when decrease-key (the common operation on dense graphs) dominates.
+//   - ARRAY: a linear scan over a key array, O(V^2) with no heap overhead,
+//     the better choice once E approaches V^2.
+// Neither needs the edge list to be built or sorted.
+class PrimMST {
+public:
+    enum class Variant { HEAP, ARRAY };
+
+    static constexpr int HEAP_ARITY = 4;
+    // Vertices settled between checks of the execution context
+    static constexpr int POLL_INTERVAL = 1024;
+
+    // weights[i] is the weight of the edge to adjacency.targets[i]. Appends
+    // the forest's edges to forest; false if the context stopped it.
+    static bool run(const AdjacencyArray& adjacency, const std::vector<int>& weights, Variant variant,
+                    std::vector<Edge>& forest, ExecutionContext& context);
+
+private:
+    // Min-heap of vertices by key, with each vertex's slot tracked so its
+    // key can be lowered in place
+    class IndexedHeap {
+    public:
+        explicit IndexedHeap(int vertexCount) : position(vertexCount, -1) {}
+
+        bool empty() const { return heap.empty(); }
+        bool contains(int v) const { return position[v] >= 0; }
+        // Inserts v or lowers its key
+        void push(int v, long long key, std::vector<long long>& keys);
+        int pop(const std::vector<long long>& keys);
+
+    private:
+        std::vector<int> heap;
+        std::vector<int> position;
+
+        void siftUp(int slot, const std::vector<long long>& keys);
+        void siftDown(int slot, const std::vector<long long>& keys);
+        void place(int slot, int v) { heap[slot] = v; position[v] = slot; }
+    };
+
+    static bool runHeap(const AdjacencyArray& adjacency, const std::vector<int>& weights,
+                        std::vector<Edge>& forest, ExecutionContext& context);
+    static bool runArray(const AdjacencyArray& adjacency, const std::vector<int>& weights,
+                         std::vector<Edge>& forest, ExecutionContext& context);
+};
+
+#endif
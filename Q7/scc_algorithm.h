@@ -0,0 +1,18 @@
+#ifndef SCC_ALGORITHM_H
+#define SCC_ALGORITHM_H
+
+#include "BaseAlgorithm.h"
+
+// Strongly connected components by iterative Tarjan (see
+// Graph::getStronglyConnectedComponents), O(V + E). On undirected graphs
+// these are the connected components.
+class SccAlgorithm : public BaseAlgorithm {
+public:
+    using BaseAlgorithm::execute;
+    AlgorithmResult execute(GraphAnalysisContext& analysis, ExecutionContext& context) override;
+    std::string getName() const override { return "Strongly Connected Components"; }
+    bool supportsDirected() const override { return true; }
+    bool supportsUndirected() const override { return true; }
+};
+
+#endif
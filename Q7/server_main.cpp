@@ -3,22 +3,32 @@
 #include <sstream>
 #include <cstring>
 #include <thread>
+#include <random>
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <unistd.h>
 #include "Graph.h"
 #include "AlgorithmFactory.h"
+#include "AlgorithmExecutor.h"
+#include "ResultCache.h"
+#include "ResultWriter.h"
 
 void handleClient(int clientSocket) {
     std::string welcome = "=== Q7 Multi-Algorithms Server ===\n"
                          "Strategy + Factory Patterns\n"
                          "Format: algorithm vertices edges edge1 edge2 ...\n"
-                         "Available: euler, clique, mst, hamilton\n"
+                         "Available: euler, clique, mst, hamilton, scc, triangles, kcore, components, diameter, pagerank\n"
                          "Example: euler 3 3 0-1 1-2 2-0\n"
-                         "Commands: help, quit\n> ";
+                         "Commands: help, stats, format text|binary, quit\n> ";
     
     send(clientSocket, welcome.c_str(), welcome.length(), 0);
     
+    ResponseFormat format = ResponseFormat::TEXT;
+    auto errorResponse = [&format](const std::string& message) {
+        if (format == ResponseFormat::BINARY) return ResultWriter::binaryError(message);
+        return "Error: " + message + "\n> ";
+    };
+    
     char buffer[1024];
     while (true) {
         memset(buffer, 0, sizeof(buffer));
@@ -36,6 +46,18 @@ void handleClient(int clientSocket) {
             break;
         } else if (input == "help") {
             response = welcome;
+        } else if (input == "stats") {
+            ResultCache::Stats cache = ResultCache::shared().getStats();
+            std::ostringstream stats;
+            stats << "=== Q7 Statistics ===\n";
+            stats << "Cache Hits: " << cache.hits << " (" << cache.canonicalHits << " isomorphic)\n";
+            stats << "Cache Misses: " << cache.misses << "\n";
+            stats << "Cache Entries: " << cache.entries << " (" << cache.bytes / 1024 << " KB of "
+                  << cache.capacity / 1024 << " KB)\n";
+            stats << "=====================\n> ";
+            response = stats.str();
+        } else if (ResultWriter::parseFormatCommand(input, format)) {
+            response = std::string("OK format ") + (format == ResponseFormat::BINARY ? "binary" : "text") + "\n> ";
         } else if (input.empty()) {
             response = "Enter algorithm request. Type 'help'.\n> ";
         } else {
@@ -46,9 +68,9 @@ void handleClient(int clientSocket) {
                 int vertices, edges;
                 
                 if (!(iss >> alg >> vertices >> edges)) {
-                    response = "Error: Format: algorithm vertices edges edge1 edge2 ...\n> ";
+                    response = errorResponse("Format: algorithm vertices edges edge1 edge2 ...");
                 } else if (!AlgorithmFactory::isValidAlgorithm(alg)) {
-                    response = "Error: Unknown algorithm. Available: euler, clique, mst, hamilton\n> ";
+                    response = errorResponse("Unknown algorithm. Available: euler, clique, mst, hamilton, scc, triangles, kcore, components, diameter, pagerank");
                 } else {
                     Graph graph(vertices, false);
                     
@@ -56,7 +78,7 @@ void handleClient(int clientSocket) {
                     for (int i = 0; i < edges; i++) {
                         std::string edge;
                         if (!(iss >> edge)) {
-                            response = "Error: Missing edges\n> ";
+                            response = errorResponse("Missing edges");
                             break;
                         }
                         
@@ -69,22 +91,39 @@ void handleClient(int clientSocket) {
                     }
                     
                     if (response.empty()) {
-                        // Execute algorithm using Factory pattern
-                        auto algorithm = AlgorithmFactory::createAlgorithm(alg);
-                        auto result = algorithm->execute(graph);
+                        // Execute algorithm using Factory pattern, or answer from the cache
+                        GraphAnalysisContext analysis(graph);
+                        ExecutionContext context;
+                        AlgorithmFactory::getConfig().applyRequestLimits(context);
+                        auto result = AlgorithmExecutor::run(AlgorithmFactory::stringToType(alg), analysis, context);
                         
-                        response = "\n=== " + alg + " RESULT ===\n";
-                        if (result.success) {
-                            response += "Result: " + result.result + "\n";
-                            response += "Time: " + std::to_string(result.executionTime) + " us\n";
+                        if (format == ResponseFormat::BINARY) {
+                            std::string body;
+                            ResultWriter::writeBinaryHeader(body, graph.getVertexCount(), graph.getEdgeCount(), 1);
+                            ResultWriter::writeBinary(body, result);
+                            ResultWriter::writeBinaryEnd(body, result.executionTime);
+                            response = ResultWriter::frame(body);
                         } else {
-                            response += "Error: " + result.error + "\n";
+                            response = "\n=== " + alg + " RESULT ===\n";
+                            if (result.success && !result.exact) {
+                                response += "Partial: " + ResultWriter::toText(result) + "\n";
+                                response += "Stopped: " + result.error + "\n";
+                                response += "Time: " + std::to_string(result.executionTime) + " us\n";
+                            } else if (result.success) {
+                                response += "Result: " + ResultWriter::toText(result) + "\n";
+                                response += "Time: " + std::to_string(result.executionTime) + " us\n";
+                            } else if (result.interrupted) {
+                                response += "Timeout: " + result.error + "\n";
+                                response += "Time: " + std::to_string(result.executionTime) + " us\n";
+                            } else {
+                                response += "Error: " + result.error + "\n";
+                            }
+                            response += "================\n> ";
                         }
-                        response += "================\n> ";
                     }
                 }
             } catch (const std::exception& e) {
-                response = "Error: " + std::string(e.what()) + "\n> ";
+                response = errorResponse(e.what());
             }
         }
         
@@ -94,9 +133,58 @@ void handleClient(int clientSocket) {
     close(clientSocket);
 }
 
+// Checks run by --test; returns the number of failures
+int runTests() {
+    int failures = 0;
+    auto check = [&failures](const std::string& what, bool passed) {
+        std::cout << what << ": " << (passed ? "YES" : "NO") << std::endl;
+        if (!passed) failures++;
+    };
+    std::mt19937 rng(42);
+    
+    std::cout << "Test 1: Max clique of a random tree (20000 vertices)" << std::endl;
+    Graph tree(20000, false);
+    for (int v = 1; v < tree.getVertexCount(); v++) {
+        tree.addEdge(v, static_cast<int>(rng() % v));
+    }
+    GraphAnalysisContext treeAnalysis(tree);
+    ExecutionContext treeContext;
+    AlgorithmResult treeClique = AlgorithmFactory::createAlgorithm("clique")->execute(treeAnalysis, treeContext);
+    std::cout << ResultWriter::toText(treeClique) << std::endl;
+    check("Accepted, exact, size 2", treeClique.success && treeClique.exact && treeClique.vertices.size() == 2);
+    
+    std::cout << "\nTest 2: Max clique of a sparse random graph (1500 vertices, average degree 4, planted K5)" << std::endl;
+    Graph sparse(1500, false);
+    while (sparse.getEdgeCount() < 3000) {
+        int u = static_cast<int>(rng() % 1500);
+        int v = static_cast<int>(rng() % 1500);
+        if (u != v && !sparse.hasEdge(u, v)) sparse.addEdge(u, v);
+    }
+    const std::vector<int> planted = {3, 141, 592, 653, 1058};
+    for (size_t i = 0; i < planted.size(); i++) {
+        for (size_t j = i + 1; j < planted.size(); j++) {
+            if (!sparse.hasEdge(planted[i], planted[j])) sparse.addEdge(planted[i], planted[j]);
+        }
+    }
+    GraphAnalysisContext sparseAnalysis(sparse);
+    ExecutionContext sparseContext;
+    AlgorithmResult sparseClique = AlgorithmFactory::createAlgorithm("clique")->execute(sparseAnalysis, sparseContext);
+    std::cout << ResultWriter::toText(sparseClique) << std::endl;
+    check("Accepted, exact, planted clique found",
+          sparseClique.success && sparseClique.exact && sparseClique.vertices == planted);
+    
+    return failures;
+}
+
 int main(int argc, char* argv[]) {
     int port = 8081;
     
+    AlgorithmFactory::setConfig(AlgorithmConfig::fromEnvironment());
+    
+    if (argc == 2 && std::string(argv[1]) == "--test") {
+        std::cout << "Running built-in tests\n" << std::endl;
+        return runTests() == 0 ? 0 : 1;
+    }
     if (argc == 2) {
         port = std::stoi(argv[1]);
     }
@@ -116,7 +204,7 @@ int main(int argc, char* argv[]) {
     
     std::cout << "Q7 Multi-Algorithms Server running on port " << port << std::endl;
     std::cout << "Design Patterns: Strategy + Factory" << std::endl;
-    std::cout << "Available algorithms: euler, clique, mst, hamilton" << std::endl;
+    std::cout << "Available algorithms: euler, clique, mst, hamilton, scc, triangles, kcore, components, diameter, pagerank" << std::endl;
     
     while (true) {
         struct sockaddr_in clientAddr;
@@ -0,0 +1,233 @@
+#include "triangle_algorithm.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#endif
+
+AlgorithmResult TriangleAlgorithm::execute(GraphAnalysisContext& analysis, ExecutionContext& context) {
+    const Graph& graph = analysis.getGraph();
+    auto start = std::chrono::high_resolution_clock::now();
+    AlgorithmResult result;
+    
+    try {
+        if (graph.isDirected()) {
+            result.success = false;
+            result.error = "Triangle counting works only on undirected graphs";
+            return result;
+        }
+        
+        const AdjacencyArray& adjacency = analysis.adjacency();
+        int n = graph.getVertexCount();
+        AdjacencyArray oriented = orient(adjacency);
+        
+        // Chunk boundaries by oriented edge count, so a chunk holding a hub
+        // is not much heavier than one of many small vertices
+        std::vector<int> bounds{0};
+        size_t edgesInChunk = 0;
+        for (int v = 0; v < n; v++) {
+            edgesInChunk += oriented.degree(v);
+            if (edgesInChunk >= CHUNK_EDGES) {
+                bounds.push_back(v + 1);
+                edgesInChunk = 0;
+            }
+        }
+        if (bounds.back() != n) bounds.push_back(n);
+        int chunks = static_cast<int>(bounds.size()) - 1;
+        
+        int maxOutDegree = 0;
+        for (int v = 0; v < n; v++) {
+            maxOutDegree = std::max(maxOutDegree, oriented.degree(v));
+        }
+        
+        WorkspacePool workspaces;
+        std::atomic<long long> triangles(0);
+        auto runChunk = [&](int chunk) {
+            if (context.charge(static_cast<long long>(oriented.offsets[bounds[chunk + 1]] -
+                                                      oriented.offsets[bounds[chunk]]))) {
+                return;
+            }
+            std::unique_ptr<Workspace> workspace;
+            {
+                std::lock_guard<std::mutex> lock(workspaces.mutex);
+                if (!workspaces.idle.empty()) {
+                    workspace = std::move(workspaces.idle.back());
+                    workspaces.idle.pop_back();
+                }
+            }
+            if (!workspace) {
+                workspace.reset(new Workspace());
+                workspace->corners.assign(n, 0);
+                workspace->common.resize(maxOutDegree);
+            }
+            triangles.fetch_add(countRange(oriented, bounds[chunk], bounds[chunk + 1], *workspace),
+                                std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(workspaces.mutex);
+            workspaces.idle.push_back(std::move(workspace));
+        };
+        
+        ThreadPool& pool = ThreadPool::shared();
+        if (chunks > 1 && pool.size() > 1) {
+            TaskGroup group(pool);
+            for (int chunk = 0; chunk < chunks; chunk++) {
+                group.run([&runChunk, chunk]() { runChunk(chunk); });
+            }
+            group.wait();
+        } else {
+            for (int chunk = 0; chunk < chunks && !context.isStopped(); chunk++) {
+                runChunk(chunk);
+            }
+        }
+        
+        if (context.isStopped()) {
+            result.markInterrupted(context);
+        } else {
+            result.kind = ResultKind::TRIANGLES;
+            result.weight = triangles.load();
+            std::vector<long long> corners(n, 0);
+            for (const auto& workspace : workspaces.idle) {
+                for (int v = 0; v < n; v++) {
+                    corners[v] += workspace->corners[v];
+                }
+            }
+            result.values.resize(n);
+            for (int v = 0; v < n; v++) {
+                long long d = adjacency.degree(v);
+                result.values[v] = d < 2 ? 0.0 : 2.0 * corners[v] / (d * (d - 1));
+            }
+            result.success = true;
+        }
+        
+    } catch (const std::exception& e) {
+        result.success = false;
+        result.error = e.what();
+    }
+    
+    auto end = std::chrono::high_resolution_clock::now();
+    result.executionTime = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    
+    return result;
+}
+
+AdjacencyArray TriangleAlgorithm::orient(const AdjacencyArray& adjacency) {
+    int n = static_cast<int>(adjacency.offsets.size()) - 1;
+    auto ranksBelow = [&adjacency](int v, int u) {
+        int dv = adjacency.degree(v), du = adjacency.degree(u);
+        return dv < du || (dv == du && v < u);
+    };
+    
+    AdjacencyArray oriented;
+    oriented.offsets.assign(n + 1, 0);
+    oriented.targets.reserve(adjacency.targets.size() / 2);
+    for (int v = 0; v < n; v++) {
+        for (const int* u = adjacency.begin(v); u != adjacency.end(v); ++u) {
+            if (ranksBelow(v, *u)) oriented.targets.push_back(*u);
+        }
+        oriented.offsets[v + 1] = static_cast<int>(oriented.targets.size());
+    }
+    return oriented;
+}
+
+long long TriangleAlgorithm::countRange(const AdjacencyArray& oriented, int first, int last,
+                                        Workspace& workspace) {
+    std::vector<long long>& corners = workspace.corners;
+    int* common = workspace.common.data();
+    long long found = 0;
+    for (int v = first; v < last; v++) {
+        long long atVertex = 0;
+        for (const int* u = oriented.begin(v); u != oriented.end(v); ++u) {
+            size_t count = intersect(oriented.begin(v), oriented.end(v), oriented.begin(*u), oriented.end(*u), common);
+            for (size_t i = 0; i < count; i++) {
+                corners[common[i]]++;
+            }
+            corners[*u] += count;
+            atVertex += count;
+        }
+        corners[v] += atVertex;
+        found += atVertex;
+    }
+    return found;
+}
+
+size_t TriangleAlgorithm::intersect(const int* a, const int* aEnd, const int* b, const int* bEnd, int* common) {
+    if (aEnd - a > bEnd - b) {
+        std::swap(a, b);
+        std::swap(aEnd, bEnd);
+    }
+    if (static_cast<size_t>(bEnd - b) >= GALLOP_RATIO * static_cast<size_t>(aEnd - a)) {
+        return intersectGallop(a, aEnd, b, bEnd, common);
+    }
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    if (hasAvx2 && aEnd - a >= 8) {
+        return intersectAvx2(a, aEnd, b, bEnd, common);
+    }
+#endif
+    return intersectMerge(a, aEnd, b, bEnd, common);
+}
+
+// Both pointers advance on equality, and every element is written to the
+// output but only kept when it matched, so the loop has no data-dependent
+// branch
+size_t TriangleAlgorithm::intersectMerge(const int* a, const int* aEnd, const int* b, const int* bEnd,
+                                         int* common) {
+    size_t count = 0;
+    while (a != aEnd && b != bEnd) {
+        int x = *a, y = *b;
+        common[count] = x;
+        count += x == y;
+        a += x <= y;
+        b += y <= x;
+    }
+    return count;
+}
+
+size_t TriangleAlgorithm::intersectGallop(const int* a, const int* aEnd, const int* b, const int* bEnd,
+                                          int* common) {
+    size_t count = 0;
+    for (; a != aEnd && b != bEnd; ++a) {
+        // Double the step until b passes *a, then binary search the last step
+        size_t step = 1;
+        while (b + step < bEnd && b[step] < *a) step *= 2;
+        b = std::lower_bound(b + step / 2, std::min(b + step + 1, bEnd), *a);
+        if (b != bEnd && *b == *a) {
+            common[count++] = *a;
+            ++b;
+        }
+    }
+    return count;
+}
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+// Blocks of eight from each list: the block of a is compared with all eight
+// rotations of the block of b, which finds every common element of the two
+// blocks, and the block with the smaller last element moves on (both on a
+// tie). Every pair of blocks whose ranges overlap is compared exactly once.
+// The rest is left to the merge.
+__attribute__((target("avx2")))
+size_t TriangleAlgorithm::intersectAvx2(const int* a, const int* aEnd, const int* b, const int* bEnd,
+                                        int* common) {
+    const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+    size_t count = 0;
+    while (aEnd - a >= 8 && bEnd - b >= 8) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+        __m256i equal = _mm256_cmpeq_epi32(va, vb);
+        for (int r = 1; r < 8; r++) {
+            vb = _mm256_permutevar8x32_epi32(vb, rotate);
+            equal = _mm256_or_si256(equal, _mm256_cmpeq_epi32(va, vb));
+        }
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(equal)));
+        while (mask) {
+            common[count++] = a[__builtin_ctz(mask)];
+            mask &= mask - 1;
+        }
+        int lastA = a[7], lastB = b[7];
+        a += lastA <= lastB ? 8 : 0;
+        b += lastB <= lastA ? 8 : 0;
+    }
+    return count + intersectMerge(a, aEnd, b, bEnd, common + count);
+}
+#endif
@@ -0,0 +1,70 @@
+#ifndef TRIANGLE_ALGORITHM_H
+#define TRIANGLE_ALGORITHM_H
+
+#include "BaseAlgorithm.h"
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Triangle count and local clustering coefficients of an undirected graph.
+//
+// Every edge is oriented from the endpoint with the lower (degree, id) rank
+// to the higher one, which leaves each vertex at most O(sqrt(E)) out-edges
+// and makes every triangle appear exactly once, at its lowest-ranked
+// vertex. For each oriented edge v->u the sorted out-lists of v and u are
+// intersected: with AVX2 (when the CPU has it) or a branch-free merge when
+// the lists are of similar length, a galloping search through the longer
+// one otherwise. O(E^1.5) in total.
+//
+// The intersections only count, writing the common vertices to a buffer;
+// each one is then credited to a per-task array of corner counts, and the
+// arrays are added up after the join, so no atomic is touched per triangle.
+//
+// Vertices are cut into chunks of about CHUNK_EDGES oriented edges that run
+// as tasks on the shared work-stealing pool, so idle workers take over
+// chunks around high-degree vertices.
+class TriangleAlgorithm : public BaseAlgorithm {
+public:
+    static constexpr size_t CHUNK_EDGES = 16384;
+    // Longer list at least this many times the shorter one: gallop
+    static constexpr size_t GALLOP_RATIO = 32;
+
+    using BaseAlgorithm::execute;
+    AlgorithmResult execute(GraphAnalysisContext& analysis, ExecutionContext& context) override;
+    std::string getName() const override { return "Triangles"; }
+    bool supportsDirected() const override { return false; }
+    bool supportsUndirected() const override { return true; }
+
+private:
+    // Corner counts of every vertex for the chunks one task ran, and room
+    // for the common vertices of one intersection
+    struct Workspace {
+        std::vector<long long> corners;
+        std::vector<int> common;
+    };
+
+    // Workspaces not in use; after the join, all of them
+    struct WorkspacePool {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Workspace>> idle;
+    };
+
+    // Out-lists of the degree orientation, sorted by vertex id
+    static AdjacencyArray orient(const AdjacencyArray& adjacency);
+
+    // Counts the triangles whose lowest-ranked vertex is in [first, last),
+    // crediting each corner in workspace; returns the triangles found
+    static long long countRange(const AdjacencyArray& oriented, int first, int last, Workspace& workspace);
+    // Common vertices of two sorted lists of distinct ids, written to
+    // common (room for the shorter list); returns how many
+    static size_t intersect(const int* a, const int* aEnd, const int* b, const int* bEnd, int* common);
+    static size_t intersectMerge(const int* a, const int* aEnd, const int* b, const int* bEnd, int* common);
+    static size_t intersectGallop(const int* a, const int* aEnd, const int* b, const int* bEnd, int* common);
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    __attribute__((target("avx2")))
+    static size_t intersectAvx2(const int* a, const int* aEnd, const int* b, const int* bEnd, int* common);
+#endif
+};
+
+#endif
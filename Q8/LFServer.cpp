@@ -10,7 +10,7 @@
 LFServer::LFServer(int serverPort, int workers) 
     : port(serverPort), serverSocket(-1), running(false), 
       numWorkers(workers), currentLeader(-1), totalConnections(0), 
-      totalRequests(0), leaderPromotions(0) {
+      totalRequests(0), interruptedResults(0), leaderPromotions(0) {
 }
 
 LFServer::~LFServer() {
@@ -93,11 +93,14 @@ void LFServer::acceptorThread() {
                              "Format: vertices edges edge1 edge2 ...\n"
                              "Server runs ALL 4 algorithms on each graph\n"
                              "Example: 3 3 0-1 1-2 2-0\n"
-                             "Commands: help, stats, quit\n> ";
+                             "Commands: help, stats, format text|binary, quit\n> ";
         sendResponse(clientSocket, welcome);
         
         // Handle client in separate thread for this connection
         std::thread([this, clientSocket, clientId]() {
+            // Cancels this connection's queued and running requests once it closes
+            CancellationToken cancellation;
+            ResponseFormat format = ResponseFormat::TEXT;
             char buffer[1024];
             while (running) {
                 memset(buffer, 0, sizeof(buffer));
@@ -119,7 +122,7 @@ void LFServer::acceptorThread() {
                                      "Format: vertices edges edge1 edge2 ...\n"
                                      "Server executes ALL 4 algorithms:\n"
                                      "- Euler Circuit\n- Max Clique\n- MST Weight\n- Hamilton Circuit\n"
-                                     "Commands: help, stats, quit\n> ";
+                                     "Commands: help, stats, format text|binary, quit\n> ";
                     sendResponse(clientSocket, help);
                 } else if (input == "stats") {
                     std::lock_guard<std::mutex> lock(statsMutex);
@@ -127,14 +130,23 @@ void LFServer::acceptorThread() {
                     stats << "=== Leader-Follower Statistics ===\n";
                     stats << "Total Connections: " << totalConnections << "\n";
                     stats << "Total Requests: " << totalRequests << "\n";
+                    stats << "Timed Out Results: " << interruptedResults << "\n";
                     stats << "Leader Promotions: " << leaderPromotions << "\n";
                     stats << "Active Workers: " << numWorkers << "\n";
                     stats << "Current Leader: " << currentLeader << "\n";
+                    ResultCache::Stats cache = ResultCache::shared().getStats();
+                    stats << "Cache Hits: " << cache.hits << " (" << cache.canonicalHits << " isomorphic)\n";
+                    stats << "Cache Misses: " << cache.misses << "\n";
+                    stats << "Cache Entries: " << cache.entries << " (" << cache.bytes / 1024 << " KB of "
+                          << cache.capacity / 1024 << " KB)\n";
                     stats << "==================================\n> ";
                     sendResponse(clientSocket, stats.str());
+                } else if (ResultWriter::parseFormatCommand(input, format)) {
+                    sendResponse(clientSocket, std::string("OK format ") +
+                                 (format == ResponseFormat::BINARY ? "binary" : "text") + "\n> ");
                 } else if (!input.empty()) {
                     // Add request to queue for Leader-Follower processing
-                    auto request = std::make_shared<ClientRequest>(clientSocket, clientId, input);
+                    auto request = std::make_shared<ClientRequest>(clientSocket, clientId, input, cancellation, format);
                     {
                         std::lock_guard<std::mutex> lock(leaderMutex);
                         requestQueue.push(request);
@@ -145,6 +157,7 @@ void LFServer::acceptorThread() {
                     sendResponse(clientSocket, "Enter graph data. Type 'help'.\n> ");
                 }
             }
+            cancellation.cancel();
             close(clientSocket);
         }).detach();
     }
@@ -185,14 +198,17 @@ void LFServer::workerThread(int workerId) {
             
             try {
                 Graph graph = parseGraph(request->graphData);
-                AllAlgorithmsResult results = executeAllAlgorithms(graph, request->clientId);
-                std::string response = formatAllResults(results, graph) + "\n> ";
+                AllAlgorithmsResult results = executeAllAlgorithms(graph, request->clientId, *request->context);
+                std::string response = formatAllResults(results, graph, request->format);
+                if (request->format == ResponseFormat::TEXT) response += "\n> ";
                 sendResponse(request->clientSocket, response);
                 
                 logRequest(request->clientId, "Completed all 4 algorithms in " + std::to_string(results.totalTime) + "us");
                 
             } catch (const std::exception& e) {
-                std::string errorResponse = "Error: " + std::string(e.what()) + "\n> ";
+                std::string errorResponse = request->format == ResponseFormat::BINARY
+                    ? ResultWriter::binaryError(e.what())
+                    : "Error: " + std::string(e.what()) + "\n> ";
                 sendResponse(request->clientSocket, errorResponse);
                 logRequest(request->clientId, "Error: " + std::string(e.what()));
             }
@@ -254,25 +270,28 @@ Graph LFServer::parseGraph(const std::string& input) {
     return graph;
 }
 
-AllAlgorithmsResult LFServer::executeAllAlgorithms(const Graph& graph, int clientId) {
+AllAlgorithmsResult LFServer::executeAllAlgorithms(const Graph& graph, int clientId, ExecutionContext& context) {
     AllAlgorithmsResult results(clientId);
     
     results.clientId = clientId;
     
     auto start = std::chrono::high_resolution_clock::now();
     
-    // Execute all 4 algorithms as required by Q8
-    auto eulerAlg = AlgorithmFactory::createAlgorithm("euler");
-    results.euler = eulerAlg->execute(graph);
+    // Execute all 4 algorithms as required by Q8, in parallel on the shared
+    // pool; degrees, components and adjacency arrays are built once and
+    // shared between them
+    GraphAnalysisContext analysis(graph);
+    std::vector<AlgorithmResult> all = AlgorithmExecutor::runAll(
+        {AlgorithmType::EULER_CIRCUIT, AlgorithmType::MAX_CLIQUE, AlgorithmType::MST_WEIGHT, AlgorithmType::HAMILTON_CIRCUIT},
+        analysis, context);
+    results.euler = std::move(all[0]);
+    results.clique = std::move(all[1]);
+    results.mst = std::move(all[2]);
+    results.hamilton = std::move(all[3]);
     
-    auto cliqueAlg = AlgorithmFactory::createAlgorithm("clique");
-    results.clique = cliqueAlg->execute(graph);
-    
-    auto mstAlg = AlgorithmFactory::createAlgorithm("mst");
-    results.mst = mstAlg->execute(graph);
-    
-    auto hamiltonAlg = AlgorithmFactory::createAlgorithm("hamilton");
-    results.hamilton = hamiltonAlg->execute(graph);
+    for (const AlgorithmResult* result : {&results.euler, &results.clique, &results.mst, &results.hamilton}) {
+        if (result->interrupted) interruptedResults++;
+    }
     
     auto end = std::chrono::high_resolution_clock::now();
     results.totalTime = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
@@ -280,38 +299,32 @@ AllAlgorithmsResult LFServer::executeAllAlgorithms(const Graph& graph, int clien
     return results;
 }
 
-std::string LFServer::formatAllResults(const AllAlgorithmsResult& results, const Graph& graph) {
+std::string LFServer::formatAllResults(const AllAlgorithmsResult& results, const Graph& graph, ResponseFormat format) {
+    if (format == ResponseFormat::BINARY) {
+        std::string body;
+        ResultWriter::writeBinaryHeader(body, graph.getVertexCount(), graph.getEdgeCount(), 4);
+        for (const AlgorithmResult* result : {&results.euler, &results.clique, &results.mst, &results.hamilton}) {
+            ResultWriter::writeBinary(body, *result);
+        }
+        ResultWriter::writeBinaryEnd(body, results.totalTime);
+        return ResultWriter::frame(body);
+    }
+    
     std::ostringstream output;
     output << "\n=== ALL 4 ALGORITHMS RESULTS (Q8) ===\n";
     output << "Graph: " << graph.getVertexCount() << " vertices, " 
            << graph.getEdgeCount() << " edges\n\n";
     
-    output << "1. EULER CIRCUIT: ";
-    if (results.euler.success) {
-        output << results.euler.result << " (" << results.euler.executionTime << "us)\n";
-    } else {
-        output << "ERROR - " << results.euler.error << "\n";
-    }
-    
-    output << "2. MAX CLIQUE: ";
-    if (results.clique.success) {
-        output << results.clique.result << " (" << results.clique.executionTime << "us)\n";
-    } else {
-        output << "ERROR - " << results.clique.error << "\n";
-    }
-    
-    output << "3. MST WEIGHT: ";
-    if (results.mst.success) {
-        output << results.mst.result << " (" << results.mst.executionTime << "us)\n";
-    } else {
-        output << "ERROR - " << results.mst.error << "\n";
-    }
-    
-    output << "4. HAMILTON CIRCUIT: ";
-    if (results.hamilton.success) {
-        output << results.hamilton.result << " (" << results.hamilton.executionTime << "us)\n";
-    } else {
-        output << "ERROR - " << results.hamilton.error << "\n";
+    const std::pair<const char*, const AlgorithmResult*> sections[] = {
+        {"1. EULER CIRCUIT: ", &results.euler},
+        {"2. MAX CLIQUE: ", &results.clique},
+        {"3. MST WEIGHT: ", &results.mst},
+        {"4. HAMILTON CIRCUIT: ", &results.hamilton},
+    };
+    for (const auto& section : sections) {
+        output << section.first;
+        ResultWriter::writeStatusText(output, *section.second);
+        output << "\n";
     }
     
     output << "\nTotal execution time: " << results.totalTime << "us";
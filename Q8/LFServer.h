@@ -7,16 +7,29 @@
 #include <queue>
 #include <vector>
 #include <atomic>
+#include <memory>
 #include "Graph.h"
 #include "AlgorithmFactory.h"
+#include "AlgorithmExecutor.h"
+#include "ResultCache.h"
+#include "ResultWriter.h"
 
 struct ClientRequest {
     int clientSocket;
     int clientId;
     std::string graphData;
+    // Limits for this request's algorithms; the deadline counts from arrival,
+    // so time spent queued for a worker is included
+    std::shared_ptr<ExecutionContext> context;
+    ResponseFormat format;
     
-    ClientRequest(int socket, int id, const std::string& data) 
-        : clientSocket(socket), clientId(id), graphData(data) {}
+    ClientRequest(int socket, int id, const std::string& data, const CancellationToken& cancellation,
+                  ResponseFormat responseFormat = ResponseFormat::TEXT) 
+        : clientSocket(socket), clientId(id), graphData(data),
+          context(std::make_shared<ExecutionContext>()), format(responseFormat) {
+        AlgorithmFactory::getConfig().applyRequestLimits(*context);
+        context->setCancellationToken(cancellation);
+    }
 };
 
 struct AllAlgorithmsResult {
@@ -46,6 +59,7 @@ private:
     std::atomic<int> currentLeader;
     std::atomic<int> totalConnections;
     std::atomic<int> totalRequests;
+    std::atomic<int> interruptedResults;
     
     // Statistics
     std::mutex statsMutex;
@@ -64,8 +78,8 @@ private:
     void workerThread(int workerId);
     void promoteNewLeader();
     Graph parseGraph(const std::string& input);
-    AllAlgorithmsResult executeAllAlgorithms(const Graph& graph, int clientId);
-    std::string formatAllResults(const AllAlgorithmsResult& results, const Graph& graph);
+    AllAlgorithmsResult executeAllAlgorithms(const Graph& graph, int clientId, ExecutionContext& context);
+    std::string formatAllResults(const AllAlgorithmsResult& results, const Graph& graph, ResponseFormat format);
     void sendResponse(int clientSocket, const std::string& response);
     void logRequest(int clientId, const std::string& message);
 };
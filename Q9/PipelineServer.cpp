@@ -13,7 +13,7 @@
 
 PipelineServer::PipelineServer(int serverPort) 
     : port(serverPort), serverSocket(-1), running(false), 
-      totalConnections(0), totalRequests(0), pipelineErrors(0) {
+      totalConnections(0), totalRequests(0), pipelineErrors(0), interruptedResults(0) {
     
     // Initialize 4 Active Objects for pipeline stages
     requestReceiver = std::make_unique<ActiveObject>("Stage1-RequestReceiver");
@@ -105,9 +105,12 @@ void PipelineServer::handleClientConnection(int clientSocket, int clientId) {
                          "Format: vertices edges edge1 edge2 ...\n"
                          "Pipeline stages: Request->Graph->Algorithms->Response\n"
                          "All 4 algorithms executed asynchronously\n"
-                         "Commands: help, stats, quit\n> ";
+                         "Commands: help, stats, format text|binary, quit\n> ";
     sendResponse(clientSocket, welcome);
     
+    // Cancels this connection's requests still in the pipeline once it closes
+    CancellationToken cancellation;
+    ResponseFormat format = ResponseFormat::TEXT;
     char buffer[1024];
     while (running.load()) {
         memset(buffer, 0, sizeof(buffer));
@@ -133,15 +136,24 @@ void PipelineServer::handleClientConnection(int clientSocket, int clientId) {
             statsStr << "\n=== Pipeline Statistics ===\n";
             statsStr << "Total Requests: " << stats.totalRequests << "\n";
             statsStr << "Pipeline Errors: " << stats.totalErrors << "\n";
+            statsStr << "Timed Out Results: " << stats.totalInterrupted << "\n";
             statsStr << "Stage 1 (Request): " << stats.stage1Processed << " processed, " << stats.stage1Queue << " queued\n";
             statsStr << "Stage 2 (Graph): " << stats.stage2Processed << " processed, " << stats.stage2Queue << " queued\n";
             statsStr << "Stage 3 (Algorithms): " << stats.stage3Processed << " processed, " << stats.stage3Queue << " queued\n";
             statsStr << "Stage 4 (Response): " << stats.stage4Processed << " processed, " << stats.stage4Queue << " queued\n";
+            ResultCache::Stats cache = ResultCache::shared().getStats();
+            statsStr << "Cache Hits: " << cache.hits << " (" << cache.canonicalHits << " isomorphic)\n";
+            statsStr << "Cache Misses: " << cache.misses << "\n";
+            statsStr << "Cache Entries: " << cache.entries << " (" << cache.bytes / 1024 << " KB of "
+                     << cache.capacity / 1024 << " KB)\n";
             statsStr << "===========================\n> ";
             sendResponse(clientSocket, statsStr.str());
+        } else if (ResultWriter::parseFormatCommand(input, format)) {
+            sendResponse(clientSocket, std::string("OK format ") +
+                         (format == ResponseFormat::BINARY ? "binary" : "text") + "\n> ");
         } else if (!input.empty()) {
             // Create request and send to pipeline Stage 1
-            auto request = std::make_shared<PipelineRequest>(clientSocket, clientId, input);
+            auto request = std::make_shared<PipelineRequest>(clientSocket, clientId, input, cancellation, format);
             totalRequests.fetch_add(1);
             
             logRequest(clientId, "Request entering Stage 1 (RequestReceiver)");
@@ -153,6 +165,7 @@ void PipelineServer::handleClientConnection(int clientSocket, int clientId) {
         }
     }
     
+    cancellation.cancel();
     close(clientSocket);
 }
 
@@ -170,7 +183,9 @@ void PipelineServer::stage1_receiveRequest(std::shared_ptr<PipelineRequest> requ
             request->clientSocket, 
             request->clientId, 
             graph, 
-            request->startTime
+            request->startTime,
+            request->context,
+            request->format
         );
         
         graphProcessor->enqueue([this, processedGraph]() {
@@ -179,7 +194,7 @@ void PipelineServer::stage1_receiveRequest(std::shared_ptr<PipelineRequest> requ
         
     } catch (const std::exception& e) {
         pipelineErrors.fetch_add(1);
-        std::string errorResponse = formatError(e.what(), request->clientId) + "\n> ";
+        std::string errorResponse = formatError(e.what(), request->clientId, request->format);
         sendResponse(request->clientSocket, errorResponse);
         logRequest(request->clientId, "Stage 1 error: " + std::string(e.what()));
     }
@@ -202,7 +217,9 @@ void PipelineServer::stage2_processGraph(std::shared_ptr<ProcessedGraph> graph)
             graph->clientSocket,
             graph->clientId,
             graph->graph,
-            graph->startTime
+            graph->startTime,
+            graph->context,
+            graph->format
         );
         
         algorithmExecutor->enqueue([this, results]() {
@@ -211,7 +228,7 @@ void PipelineServer::stage2_processGraph(std::shared_ptr<ProcessedGraph> graph)
         
     } catch (const std::exception& e) {
         pipelineErrors.fetch_add(1);
-        std::string errorResponse = formatError(e.what(), graph->clientId) + "\n> ";
+        std::string errorResponse = formatError(e.what(), graph->clientId, graph->format);
         sendResponse(graph->clientSocket, errorResponse);
         logRequest(graph->clientId, "Stage 2 error: " + std::string(e.what()));
     }
@@ -222,18 +239,21 @@ void PipelineServer::stage3_executeAlgorithms(std::shared_ptr<AlgorithmResults>
     try {
         logRequest(results->clientId, "Stage 3: Executing all 4 algorithms");
         
-        // Execute all 4 algorithms as required by Q9
-        auto eulerAlg = AlgorithmFactory::createAlgorithm("euler");
-        results->euler = eulerAlg->execute(results->graph);
+        // Execute all 4 algorithms as required by Q9, in parallel on the
+        // shared pool; degrees, components and adjacency arrays are built
+        // once and shared between them
+        GraphAnalysisContext analysis(results->graph);
+        std::vector<AlgorithmResult> all = AlgorithmExecutor::runAll(
+            {AlgorithmType::EULER_CIRCUIT, AlgorithmType::MAX_CLIQUE, AlgorithmType::MST_WEIGHT, AlgorithmType::HAMILTON_CIRCUIT},
+            analysis, *results->context);
+        results->euler = std::move(all[0]);
+        results->clique = std::move(all[1]);
+        results->mst = std::move(all[2]);
+        results->hamilton = std::move(all[3]);
         
-        auto cliqueAlg = AlgorithmFactory::createAlgorithm("clique");
-        results->clique = cliqueAlg->execute(results->graph);
-        
-        auto mstAlg = AlgorithmFactory::createAlgorithm("mst");
-        results->mst = mstAlg->execute(results->graph);
-        
-        auto hamiltonAlg = AlgorithmFactory::createAlgorithm("hamilton");
-        results->hamilton = hamiltonAlg->execute(results->graph);
+        for (const AlgorithmResult* result : {&results->euler, &results->clique, &results->mst, &results->hamilton}) {
+            if (result->interrupted) interruptedResults.fetch_add(1);
+        }
         
         logRequest(results->clientId, "Stage 3 -> Stage 4");
         
@@ -244,7 +264,7 @@ void PipelineServer::stage3_executeAlgorithms(std::shared_ptr<AlgorithmResults>
         
     } catch (const std::exception& e) {
         pipelineErrors.fetch_add(1);
-        std::string errorResponse = formatError(e.what(), results->clientId) + "\n> ";
+        std::string errorResponse = formatError(e.what(), results->clientId, results->format);
         sendResponse(results->clientSocket, errorResponse);
         logRequest(results->clientId, "Stage 3 error: " + std::string(e.what()));
     }
@@ -255,7 +275,7 @@ void PipelineServer::stage4_formatResponse(std::shared_ptr<AlgorithmResults> res
     try {
         logRequest(results->clientId, "Stage 4: Formatting and sending response");
         
-        std::string response = formatPipelineResponse(*results) + "\n> ";
+        std::string response = formatPipelineResponse(*results);
         sendResponse(results->clientSocket, response);
         
         auto endTime = std::chrono::high_resolution_clock::now();
@@ -265,7 +285,7 @@ void PipelineServer::stage4_formatResponse(std::shared_ptr<AlgorithmResults> res
         
     } catch (const std::exception& e) {
         pipelineErrors.fetch_add(1);
-        std::string errorResponse = formatError(e.what(), results->clientId) + "\n> ";
+        std::string errorResponse = formatError(e.what(), results->clientId, results->format);
         sendResponse(results->clientSocket, errorResponse);
         logRequest(results->clientId, "Stage 4 error: " + std::string(e.what()));
     }
@@ -310,29 +330,40 @@ Graph PipelineServer::parseGraphInput(const std::string& input) {
 }
 
 std::string PipelineServer::formatPipelineResponse(const AlgorithmResults& results) {
+    if (results.format == ResponseFormat::BINARY) {
+        std::string body;
+        ResultWriter::writeBinaryHeader(body, results.graph.getVertexCount(), results.graph.getEdgeCount(), 4);
+        for (const AlgorithmResult* result : {&results.euler, &results.clique, &results.mst, &results.hamilton}) {
+            ResultWriter::writeBinary(body, *result);
+        }
+        auto elapsed = std::chrono::high_resolution_clock::now() - results.startTime;
+        ResultWriter::writeBinaryEnd(body, std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+        return ResultWriter::frame(body);
+    }
+    
     std::ostringstream output;
     output << "\n=== PIPELINE RESULTS (4 Active Objects) ===\n";
     output << "Graph: " << results.graph.getVertexCount() << " vertices, " 
            << results.graph.getEdgeCount() << " edges\n\n";
     
     output << "1. EULER: ";
-    output << (results.euler.success ? results.euler.result : "ERROR - " + results.euler.error);
-    output << " (" << results.euler.executionTime << "us)\n";
+    ResultWriter::writeStatusText(output, results.euler);
+    output << "\n";
     
     output << "2. CLIQUE: ";
-    output << (results.clique.success ? results.clique.result : "ERROR - " + results.clique.error);
-    output << " (" << results.clique.executionTime << "us)\n";
+    ResultWriter::writeStatusText(output, results.clique);
+    output << "\n";
     
     output << "3. MST: ";
-    output << (results.mst.success ? results.mst.result : "ERROR - " + results.mst.error);
-    output << " (" << results.mst.executionTime << "us)\n";
+    ResultWriter::writeStatusText(output, results.mst);
+    output << "\n";
     
     output << "4. HAMILTON: ";
-    output << (results.hamilton.success ? results.hamilton.result : "ERROR - " + results.hamilton.error);
-    output << " (" << results.hamilton.executionTime << "us)\n";
+    ResultWriter::writeStatusText(output, results.hamilton);
+    output << "\n";
     
     output << "\nProcessed through 4-stage pipeline";
-    output << "\n========================================";
+    output << "\n========================================\n> ";
     
     return output.str();
 }
@@ -341,6 +372,7 @@ PipelineServer::PipelineStats PipelineServer::getStats() {
     PipelineStats stats;
     stats.totalRequests = totalRequests.load();
     stats.totalErrors = pipelineErrors.load();
+    stats.totalInterrupted = interruptedResults.load();
     stats.stage1Processed = requestReceiver->getProcessedTaskCount();
     stats.stage2Processed = graphProcessor->getProcessedTaskCount();
     stats.stage3Processed = algorithmExecutor->getProcessedTaskCount();
@@ -367,7 +399,8 @@ void PipelineServer::logRequest(int clientId, const std::string& message) {
     std::cout << "[" << timeStr << "] [Client " << clientId << "] " << message << std::endl;
 }
 
-std::string PipelineServer::formatError(const std::string& error, int clientId) {
+std::string PipelineServer::formatError(const std::string& error, int clientId, ResponseFormat format) {
+    if (format == ResponseFormat::BINARY) return ResultWriter::binaryError(error);
     return "\n=== PIPELINE ERROR (Client " + std::to_string(clientId) + ") ===\n" + 
-           error + "\n==============================";
+           error + "\n==============================\n> ";
 }
\ No newline at end of file
@@ -9,17 +9,29 @@
 #include "ActiveObject.h"
 #include "Graph.h"
 #include "AlgorithmFactory.h"
+#include "AlgorithmExecutor.h"
+#include "ResultCache.h"
 #include "BaseAlgorithm.h"
+#include "ResultWriter.h"
 
 struct PipelineRequest {
     int clientSocket;
     int clientId;
     std::string inputData;
     std::chrono::high_resolution_clock::time_point startTime;
+    // Limits for this request's algorithms, carried through every stage; the
+    // deadline counts from arrival, so time queued in earlier stages is included
+    std::shared_ptr<ExecutionContext> context;
+    ResponseFormat format;
     
-    PipelineRequest(int socket, int id, const std::string& data)
+    PipelineRequest(int socket, int id, const std::string& data, const CancellationToken& cancellation,
+                    ResponseFormat responseFormat = ResponseFormat::TEXT)
         : clientSocket(socket), clientId(id), inputData(data),
-          startTime(std::chrono::high_resolution_clock::now()) {}
+          startTime(std::chrono::high_resolution_clock::now()),
+          context(std::make_shared<ExecutionContext>()), format(responseFormat) {
+        AlgorithmFactory::getConfig().applyRequestLimits(*context);
+        context->setCancellationToken(cancellation);
+    }
 };
 
 struct ProcessedGraph {
@@ -27,14 +39,19 @@ struct ProcessedGraph {
     int clientId;
     Graph graph;
     std::chrono::high_resolution_clock::time_point startTime;
+    std::shared_ptr<ExecutionContext> context;
+    ResponseFormat format;
     
     // Default constructor
-    ProcessedGraph() : clientSocket(-1), clientId(-1), graph(1, false) {}
+    ProcessedGraph() : clientSocket(-1), clientId(-1), graph(1, false),
+                       context(std::make_shared<ExecutionContext>()), format(ResponseFormat::TEXT) {}
     
     // Constructor with parameters
     ProcessedGraph(int socket, int id, const Graph& g, 
-                   const std::chrono::high_resolution_clock::time_point& time)
-        : clientSocket(socket), clientId(id), graph(g), startTime(time) {}
+                   const std::chrono::high_resolution_clock::time_point& time,
+                   const std::shared_ptr<ExecutionContext>& ctx, ResponseFormat responseFormat)
+        : clientSocket(socket), clientId(id), graph(g), startTime(time), context(ctx),
+          format(responseFormat) {}
 };
 
 struct AlgorithmResults {
@@ -46,14 +63,19 @@ struct AlgorithmResults {
     AlgorithmResult mst;
     AlgorithmResult hamilton;
     std::chrono::high_resolution_clock::time_point startTime;
+    std::shared_ptr<ExecutionContext> context;
+    ResponseFormat format;
     
     // Default constructor
-    AlgorithmResults() : clientSocket(-1), clientId(-1), graph(1, false) {}
+    AlgorithmResults() : clientSocket(-1), clientId(-1), graph(1, false),
+                         context(std::make_shared<ExecutionContext>()), format(ResponseFormat::TEXT) {}
     
     // Constructor with parameters
     AlgorithmResults(int socket, int id, const Graph& g,
-                     const std::chrono::high_resolution_clock::time_point& time)
-        : clientSocket(socket), clientId(id), graph(g), startTime(time) {}
+                     const std::chrono::high_resolution_clock::time_point& time,
+                     const std::shared_ptr<ExecutionContext>& ctx, ResponseFormat responseFormat)
+        : clientSocket(socket), clientId(id), graph(g), startTime(time), context(ctx),
+          format(responseFormat) {}
 };
 
 class PipelineServer {
@@ -72,6 +94,7 @@ private:
     std::atomic<int> totalConnections;
     std::atomic<int> totalRequests;
     std::atomic<int> pipelineErrors;
+    std::atomic<int> interruptedResults;
     std::mutex statsMutex;
     
 public:
@@ -86,6 +109,7 @@ public:
     struct PipelineStats {
         int totalRequests;
         int totalErrors;
+        int totalInterrupted;
         int stage1Processed;
         int stage2Processed;
         int stage3Processed;
@@ -113,7 +137,7 @@ private:
     std::string formatPipelineResponse(const AlgorithmResults& results);
     void sendResponse(int clientSocket, const std::string& response);
     void logRequest(int clientId, const std::string& message);
-    std::string formatError(const std::string& error, int clientId);
+    std::string formatError(const std::string& error, int clientId, ResponseFormat format);
 };
 
 #endif
\ No newline at end of file
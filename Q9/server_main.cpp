@@ -35,6 +35,8 @@ int main(int argc, char* argv[]) {
     }
     
     try {
+        AlgorithmFactory::setConfig(AlgorithmConfig::fromEnvironment());
+        
         signal(SIGINT, signalHandler);
         signal(SIGTERM, signalHandler);
         